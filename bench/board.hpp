@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <puyo/game/core/constants.hpp>
+#include <puyo/game/core/ecs/coordinator.hpp>
+#include <puyo/game/core/ecs/entity.hpp>
+
+#include <puyo/game/components/gameplay/chains.hpp>
+#include <puyo/game/components/gameplay/color.hpp>
+#include <puyo/game/components/gameplay/falling.hpp>
+#include <puyo/game/components/gameplay/grid.hpp>
+#include <puyo/game/components/gameplay/score.hpp>
+#include <puyo/game/components/gameplay/state.hpp>
+#include <puyo/game/components/graphics/drawable.hpp>
+#include <puyo/game/components/movement/transform.hpp>
+#include <puyo/game/components/movement/velocity.hpp>
+
+namespace puyo
+{
+	namespace bench
+	{
+		// Canned boards, one string per row from the top; R, Y, G and B are the four colours.
+		using board_rows = const char *[grid_height];
+
+		inline constexpr board_rows empty_board{
+			"........", "........", "........", "........",
+			"........", "........", "........", "........",
+			"........", "........", "........", "........",
+			"........", "........", "........", "........"
+		};
+
+		// Full board without a single pair of touching same-colour cells: every cell is its own group.
+		inline constexpr board_rows checkerboard{
+			"RYRYRYRY", "GBGBGBGB", "RYRYRYRY", "GBGBGBGB",
+			"RYRYRYRY", "GBGBGBGB", "RYRYRYRY", "GBGBGBGB",
+			"RYRYRYRY", "GBGBGBGB", "RYRYRYRY", "GBGBGBGB",
+			"RYRYRYRY", "GBGBGBGB", "RYRYRYRY", "GBGBGBGB"
+		};
+
+		// Resolves as a 19-chain, exactly one group popping per step.
+		inline constexpr board_rows chain_19{
+			"........", "........", "..G.....", "..G.B...",
+			".YGBRY..", ".YRBRY..", ".YGYGY..", "GBRYRG..",
+			"GYRBRG..", "BYRBRY..", "BYGRGR..", "BRYBBY..",
+			"YRGYGGB.", "YRYBYYB.", "YYGGRGG.", "GGYRYBB."
+		};
+
+		// Bottom four rows one red group, everything above it a three-colour diagonal that never
+		// touches itself, so clearing the red drops 96 blobs by four rows.
+		inline constexpr board_rows tower{
+			"YGBYGBYG", "GBYGBYGB", "BYGBYGBY", "YGBYGBYG",
+			"GBYGBYGB", "BYGBYGBY", "YGBYGBYG", "GBYGBYGB",
+			"BYGBYGBY", "YGBYGBYG", "GBYGBYGB", "BYGBYGBY",
+			"RRRRRRRR", "RRRRRRRR", "RRRRRRRR", "RRRRRRRR"
+		};
+
+		// A coordinator holding the same singletons as game plus one blob entity per filled cell.
+		struct board final
+		{
+			std::unique_ptr<coordinator> coord;
+
+			entity
+				gr = 0u,
+				fall = 0u,
+				ch = 0u,
+				sc = 0u;
+		};
+
+		inline color_t to_color(char c)
+		{
+			switch (c)
+			{
+			case 'R': return red;
+			case 'Y': return yellow;
+			case 'G': return green;
+			default:
+				assert(c == 'B' && "Unknown colour in canned board.");
+				return blue;
+			}
+		}
+
+		inline board make_board(const board_rows &rows)
+		{
+			board b{ std::make_unique<coordinator>() };
+			coordinator &coord = *b.coord;
+
+			coord.register_component<color>();
+			coord.register_component<falling>();
+			coord.register_component<grid>();
+			coord.register_component<chains>();
+			coord.register_component<score>();
+			coord.register_component<state>();
+			coord.register_component<drawable>();
+			coord.register_component<transform>();
+			coord.register_component<velocity>();
+
+			coord.track_changes<transform>();
+
+			b.gr = coord.create_entity();
+			coord.add_component<grid>(b.gr, { { 0 } });
+
+			b.fall = coord.create_entity();
+			coord.add_component<falling>(b.fall, { /* empty */ });
+
+			b.ch = coord.create_entity();
+			coord.add_component<chains>(b.ch, { /* empty */ });
+
+			b.sc = coord.create_entity();
+			coord.add_component<score>(b.sc, { /* empty */ });
+
+			auto &g = coord.get_component<grid>(b.gr);
+
+			for (int y = 0; y < static_cast<int>(grid_height); ++y)
+			{
+				for (int x = 0; x < static_cast<int>(grid_width); ++x)
+				{
+					const char c = rows[y][x];
+
+					if (c == '.')
+						continue;
+
+					const color_t col = to_color(c);
+					const sdl::fpoint pos{ float(x) * x_interval<>, float(y) * y_interval<> };
+
+					entity blob = coord.create_entity();
+					coord.add_components(blob,
+						color{ col },
+						state{ state_t::placed },
+						transform{ pos, { x, y } },
+						velocity{ puyo::speed },
+						drawable{
+							0,
+							{ { (col - 1) * 50, 0 }, { 50, 50 } },
+							{ pos, { x_interval<>, x_interval<> } }
+						}
+					);
+
+					place_blob(g, x + y * grid_width, blob, col);
+				}
+			}
+
+			return b;
+		}
+	}
+}
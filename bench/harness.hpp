@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace puyo
+{
+	namespace bench
+	{
+		// Bumped by the replacement operator new in main.cpp.
+		inline std::size_t allocations{ 0 };
+
+		// Runs `setup` then times `body`, which returns how many operations it performed.
+		// The first repetition is a warm-up and is not reported, so allocs/op reflects the
+		// steady state rather than first-use growth.
+		template <typename Setup, typename Body>
+		void run(const char *name, std::size_t reps, Setup &&setup, Body &&body)
+		{
+			using clock = std::chrono::steady_clock;
+
+			setup();
+			body();
+
+			std::chrono::nanoseconds elapsed{ 0 };
+			std::uint64_t ops = 0;
+			std::size_t allocs = 0;
+
+			for (std::size_t i = 0; i < reps; ++i)
+			{
+				setup();
+
+				const std::size_t before = allocations;
+				const auto start = clock::now();
+
+				ops += body();
+
+				elapsed += clock::now() - start;
+				allocs += allocations - before;
+			}
+
+			const double per_op = ops != 0u ? 1.0 / static_cast<double>(ops) : 0.0;
+
+			std::printf("%-44s %12.1f ns/op %10.3f allocs/op %12llu ops\n",
+				name, static_cast<double>(elapsed.count()) * per_op, static_cast<double>(allocs) * per_op, static_cast<unsigned long long>(ops));
+		}
+
+		template <typename Body>
+		void run(const char *name, std::size_t reps, Body &&body)
+		{
+			run(name, reps, [] {}, body);
+		}
+	}
+}
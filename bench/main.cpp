@@ -0,0 +1,571 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include <puyo/common/thread_pool.hpp>
+
+#include <puyo/game/core/bitboard.hpp>
+#include <puyo/game/core/chain_resolver.hpp>
+#include <puyo/game/core/constants.hpp>
+#include <puyo/game/core/move_generator.hpp>
+#include <puyo/game/core/piece_generator.hpp>
+#include <puyo/game/core/zobrist.hpp>
+#include <puyo/game/core/ecs/command_buffer.hpp>
+#include <puyo/game/core/ecs/coordinator.hpp>
+#include <puyo/game/core/ecs/entity.hpp>
+#include <puyo/game/core/ecs/scheduler.hpp>
+#include <puyo/game/core/ecs/snapshot.hpp>
+
+#include <puyo/game/components/movement/transform.hpp>
+
+#include <puyo/game/systems/gameplay/clear_chains.hpp>
+#include <puyo/game/systems/gameplay/filter_chains.hpp>
+#include <puyo/game/systems/gameplay/spawn_pair.hpp>
+#include <puyo/game/systems/gameplay/find_combos.hpp>
+#include <puyo/game/systems/graphics/render_grid.hpp>
+#include <puyo/game/systems/movement/fall_pieces.hpp>
+#include <puyo/game/systems/movement/settle_pieces.hpp>
+
+#include "board.hpp"
+#include "harness.hpp"
+
+void *operator new(std::size_t size)
+{
+	++puyo::bench::allocations;
+
+	if (void *p = std::malloc(size != 0u ? size : 1u))
+		return p;
+
+	throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size)
+{
+	return ::operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace
+{
+	// Keeps results observable so the optimiser cannot drop the measured work.
+	volatile std::uintptr_t sink;
+
+	constexpr std::size_t batch{ 256 };
+
+	struct null_graphics final
+	{
+		std::size_t calls{ 0 };
+		float checksum{ 0.f };
+
+		void render(std::size_t idx, const puyo::sdl::irect &, const puyo::sdl::frect &dst) noexcept
+		{
+			++calls;
+			checksum += dst.x() + dst.y() + static_cast<float>(idx);
+		}
+	};
+
+	void bench_entities()
+	{
+		auto coord = std::make_unique<puyo::coordinator>();
+		std::array<puyo::entity, batch> ids{};
+
+		puyo::bench::run("coordinator::create_entity/destroy_entity", 2000u,
+			[&]
+			{
+				for (auto &id : ids)
+					id = coord->create_entity();
+
+				for (auto id : ids)
+					coord->destroy_entity(id);
+
+				return 2u * batch;
+			}
+		);
+	}
+
+	// Every blob of a full board, one destroy_entity at a time and as one batch.
+	void bench_destroy_blobs()
+	{
+		puyo::bench::board b;
+		std::array<puyo::entity, puyo::grid_size> ids{};
+
+		const auto setup = [&]
+		{
+			b = puyo::bench::make_board(puyo::bench::checkerboard);
+			ids = b.coord->get_component<puyo::grid>(b.gr).board_blobs;
+		};
+
+		puyo::bench::run("coordinator::destroy_entity (128 blobs)", 200u, setup,
+			[&]
+			{
+				for (auto id : ids)
+					b.coord->destroy_entity(id);
+
+				return ids.size();
+			}
+		);
+
+		puyo::bench::run("coordinator::destroy_entities (128 blobs)", 200u, setup,
+			[&]
+			{
+				b.coord->destroy_entities(ids.data(), ids.size());
+				return ids.size();
+			}
+		);
+
+		puyo::bench::run("coordinator::clear (128 blobs)", 200u, setup,
+			[&]
+			{
+				b.coord->clear();
+				return ids.size();
+			}
+		);
+	}
+
+	// 128 blobs onto an empty board, component by component and from the blob prefab.
+	void bench_spawn_blobs()
+	{
+		puyo::bench::board b;
+		std::array<puyo::entity, puyo::grid_size> ids{};
+
+		// Filled and cleared once first, so storage growth is not timed.
+		const auto setup = [&]
+		{
+			b = puyo::bench::make_board(puyo::bench::empty_board);
+			b.coord->instantiate(puyo::sys::blob_prefab(), ids.data(), ids.size());
+			b.coord->clear();
+		};
+
+		puyo::bench::run("coordinator::add_components (128 blobs)", 200u, setup,
+			[&]
+			{
+				const auto &blob = puyo::sys::blob_prefab().components();
+
+				for (auto &id : ids)
+				{
+					id = b.coord->create_entity();
+					b.coord->add_components(id, std::get<puyo::color>(blob), std::get<puyo::state>(blob), std::get<puyo::transform>(blob),
+						std::get<puyo::velocity>(blob), std::get<puyo::drawable>(blob));
+				}
+
+				return ids.size();
+			}
+		);
+
+		puyo::bench::run("coordinator::instantiate (128 blobs)", 200u, setup,
+			[&]
+			{
+				b.coord->instantiate(puyo::sys::blob_prefab(), ids.data(), ids.size());
+				return ids.size();
+			}
+		);
+	}
+
+	void bench_components()
+	{
+		auto coord = std::make_unique<puyo::coordinator>();
+		coord->register_component<puyo::transform>();
+
+		std::array<puyo::entity, batch> ids{};
+
+		for (auto &id : ids)
+			id = coord->create_entity();
+
+		puyo::bench::run("coordinator::add_component/remove_component", 2000u,
+			[&]
+			{
+				for (std::size_t i = 0; i < batch; ++i)
+					coord->add_component<puyo::transform>(ids[i], { { float(i), 0.f }, { int(i), 0 } });
+
+				for (auto id : ids)
+					coord->remove_component<puyo::transform>(id);
+
+				return 2u * batch;
+			}
+		);
+
+		for (std::size_t i = 0; i < batch; ++i)
+			coord->add_component<puyo::transform>(ids[i], { { float(i), 0.f }, { int(i), 0 } });
+
+		puyo::bench::run("coordinator::get_component", 2000u,
+			[&]
+			{
+				int sum = 0;
+
+				for (auto id : ids)
+					sum += coord->get_component<puyo::transform>(id).grid_position.x();
+
+				sink = static_cast<std::uintptr_t>(sum);
+				return batch;
+			}
+		);
+	}
+
+	void bench_find_combos(const char *name, const puyo::bench::board_rows &rows)
+	{
+		auto b = puyo::bench::make_board(rows);
+
+		auto &cs = b.coord->get_component<puyo::chains>(b.ch);
+
+		// Forgetting the last scan makes every blob count as moved, so each call floods the whole board.
+		puyo::bench::run(name, 200u,
+			[&]
+			{
+				for (std::size_t i = 0; i < batch; ++i)
+				{
+					cs.scanned = 0u;
+					puyo::sys::find_combos(*b.coord, b.gr, b.ch);
+					sink = cs.count;
+				}
+
+				return batch;
+			}
+		);
+	}
+
+	// Only two blobs count as moved, as after a pair lands, so just their groups are flooded.
+	void bench_find_combos_moved(const char *name, const puyo::bench::board_rows &rows)
+	{
+		auto b = puyo::bench::make_board(rows);
+
+		auto &g = b.coord->get_component<puyo::grid>(b.gr);
+		auto &cs = b.coord->get_component<puyo::chains>(b.ch);
+
+		const puyo::entity landed[] = {
+			g.board_blobs[(puyo::grid_height - 1u) * puyo::grid_width],
+			g.board_blobs[(puyo::grid_height - 2u) * puyo::grid_width]
+		};
+
+		puyo::bench::run(name, 200u,
+			[&]
+			{
+				for (std::size_t i = 0; i < batch; ++i)
+				{
+					for (auto e : landed)
+						static_cast<void>(b.coord->patch<puyo::transform>(e));
+
+					puyo::sys::find_combos(*b.coord, b.gr, b.ch);
+					sink = cs.count;
+				}
+
+				return batch;
+			}
+		);
+	}
+
+	void bench_fall_pieces()
+	{
+		puyo::bench::board b;
+		puyo::command_buffer cmds;
+
+		// Clears the bottom four rows in setup, so only the fall back down is timed.
+		puyo::bench::run("fall_pieces after clearing 32 blobs", 200u,
+			[&]
+			{
+				b = puyo::bench::make_board(puyo::bench::tower);
+
+				auto &cs = b.coord->get_component<puyo::chains>(b.ch);
+				puyo::bitboard bottom{ 0u, 0xFFFFFFFF00000000u };
+
+				cs.groups[0] = { bottom, puyo::red, bottom.count() };
+				cs.count = 1u;
+
+				puyo::sys::clear_chains(*b.coord, cmds, b.gr, b.fall, b.ch, b.sc);
+				cmds.flush(*b.coord);
+			},
+			[&]
+			{
+				std::size_t steps = 1;
+
+				while (puyo::sys::fall_pieces(*b.coord, b.gr, b.fall, b.ch, 1.f / 60.f))
+					++steps;
+
+				return steps;
+			}
+		);
+	}
+
+	// The same fall resolved in one call; each op is the whole fall rather than a step of it.
+	void bench_settle_pieces()
+	{
+		puyo::bench::board b;
+		puyo::command_buffer cmds;
+
+		puyo::bench::run("settle_pieces after clearing 32 blobs", 200u,
+			[&]
+			{
+				b = puyo::bench::make_board(puyo::bench::tower);
+
+				auto &cs = b.coord->get_component<puyo::chains>(b.ch);
+				puyo::bitboard bottom{ 0u, 0xFFFFFFFF00000000u };
+
+				cs.groups[0] = { bottom, puyo::red, bottom.count() };
+				cs.count = 1u;
+
+				puyo::sys::clear_chains(*b.coord, cmds, b.gr, b.fall, b.ch, b.sc);
+				cmds.flush(*b.coord);
+			},
+			[&]
+			{
+				puyo::sys::settle_pieces(*b.coord, b.gr, b.fall);
+				return 1u;
+			}
+		);
+	}
+
+	// Same fall as above, driven through a scheduler: fall_pieces and filter_chains share no
+	// writes, so they form one wave and run side by side on the pool.
+	void bench_scheduler()
+	{
+		puyo::bench::board b;
+		puyo::command_buffer cmds;
+		puyo::thread_pool pool;
+		puyo::scheduler schedule;
+		bool falling = false;
+		bool chained = false;
+
+		schedule.add<puyo::sys::fall_pieces_access>(
+			[&](puyo::coordinator &coord, puyo::command_buffer &)
+			{
+				falling = puyo::sys::fall_pieces(coord, b.gr, b.fall, b.ch, 1.f / 60.f);
+			}
+		);
+
+		schedule.add<puyo::sys::filter_chains_access>(
+			[&](puyo::coordinator &coord, puyo::command_buffer &)
+			{
+				chained = puyo::sys::filter_chains(coord, b.ch);
+			}
+		);
+
+		puyo::bench::run("scheduler: fall_pieces + filter_chains", 200u,
+			[&]
+			{
+				b = puyo::bench::make_board(puyo::bench::tower);
+
+				auto &cs = b.coord->get_component<puyo::chains>(b.ch);
+				puyo::bitboard bottom{ 0u, 0xFFFFFFFF00000000u };
+
+				cs.groups[0] = { bottom, puyo::red, bottom.count() };
+				cs.count = 1u;
+
+				puyo::sys::clear_chains(*b.coord, cmds, b.gr, b.fall, b.ch, b.sc);
+				cmds.flush(*b.coord);
+			},
+			[&]
+			{
+				std::size_t steps = 0;
+
+				do
+				{
+					schedule.run(*b.coord, &pool);
+					++steps;
+				} while (falling);
+
+				sink = chained;
+				return steps;
+			}
+		);
+	}
+
+	void bench_snapshot(const char *name, const puyo::bench::board_rows &rows)
+	{
+		auto b = puyo::bench::make_board(rows);
+		puyo::snapshot snap;
+
+		puyo::bench::run(name, 200u,
+			[&]
+			{
+				for (std::size_t i = 0; i < batch; ++i)
+				{
+					snap.clear();
+					b.coord->save(snap);
+
+					puyo::snapshot_reader reader{ snap };
+					b.coord->restore(reader);
+				}
+
+				sink = snap.size();
+				return batch;
+			}
+		);
+	}
+
+	void bench_pieces()
+	{
+		puyo::piece_generator pieces{ 1u };
+
+		puyo::bench::run("piece_generator::next", 2000u,
+			[&]
+			{
+				std::uintptr_t sum = 0;
+
+				for (std::size_t i = 0; i < batch; ++i)
+				{
+					const puyo::piece p = pieces.next();
+					sum += p.center + p.other;
+				}
+
+				sink = sum;
+				return batch;
+			}
+		);
+	}
+
+	// From the third column of the top row, held with the other blob below, as pairs spawn.
+	void bench_placements(const char *name, const puyo::bench::board_rows &rows, puyo::color_t other)
+	{
+		auto b = puyo::bench::make_board(rows);
+		const auto &boards = b.coord->get_component<puyo::grid>(b.gr).color_boards;
+		puyo::placements out;
+
+		puyo::bench::run(name, 2000u,
+			[&]
+			{
+				std::size_t count = 0;
+
+				for (std::size_t i = 0; i < batch; ++i)
+					count += puyo::generate_placements(boards, 3u, puyo::orientation::down, puyo::red, other, out.data());
+
+				sink = count + out[0].center_cell;
+				return batch;
+			}
+		);
+	}
+
+	// One op is one chain step, so ns/op is the inverse of chains per second.
+	void bench_resolve_chains()
+	{
+		auto b = puyo::bench::make_board(puyo::bench::chain_19);
+		const auto &boards = b.coord->get_component<puyo::grid>(b.gr).color_boards;
+
+		puyo::bench::run("resolve_chains (19-chain board, per chain)", 2000u,
+			[&]
+			{
+				const puyo::chain_result r = puyo::resolve_chains(boards);
+
+				sink = static_cast<std::uintptr_t>(r.score) + r.boards[0].lo;
+				return static_cast<std::size_t>(r.chains);
+			}
+		);
+	}
+
+	// Every placement of a pair on the 19-chain board, each run to rest; one op per placement.
+	void bench_evaluate_placements()
+	{
+		auto b = puyo::bench::make_board(puyo::bench::chain_19);
+		const auto &boards = b.coord->get_component<puyo::grid>(b.gr).color_boards;
+		puyo::placements out;
+
+		puyo::bench::run("evaluate placements (19-chain board)", 2000u,
+			[&]
+			{
+				const std::size_t count = puyo::generate_placements(boards, 3u, puyo::orientation::down, puyo::red, puyo::blue, out.data());
+				int best = 0;
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const puyo::chain_result r = puyo::resolve_chains(out[i]);
+
+					if (r.score > best)
+						best = r.score;
+				}
+
+				sink = static_cast<std::uintptr_t>(best);
+				return count;
+			}
+		);
+	}
+
+	// The from-scratch hash the incremental one is checked against; grid::hash itself costs a
+	// load.
+	void bench_zobrist()
+	{
+		auto b = puyo::bench::make_board(puyo::bench::checkerboard);
+		const auto &boards = b.coord->get_component<puyo::grid>(b.gr).color_boards;
+
+		puyo::bench::run("zobrist_hash (128 blobs, from scratch)", 2000u,
+			[&]
+			{
+				std::uint64_t hash = 0u;
+
+				for (std::size_t i = 0; i < batch; ++i)
+					hash += puyo::zobrist_hash(boards);
+
+				sink = static_cast<std::uintptr_t>(hash);
+				return batch;
+			}
+		);
+	}
+
+	void bench_render_grid()
+	{
+		auto b = puyo::bench::make_board(puyo::bench::checkerboard);
+		null_graphics gfx;
+		std::uint32_t rendered = 0;
+
+		puyo::bench::run("render_grid (128 blobs, null renderer)", 200u,
+			[&]
+			{
+				for (std::size_t i = 0; i < batch; ++i)
+					puyo::sys::render_grid(*b.coord, gfx, rendered);
+
+				sink = gfx.calls + static_cast<std::uintptr_t>(gfx.checksum);
+				return batch;
+			}
+		);
+	}
+}
+
+int main()
+{
+	bench_entities();
+	bench_destroy_blobs();
+	bench_spawn_blobs();
+	bench_components();
+	bench_pieces();
+	bench_zobrist();
+
+	bench_find_combos("find_combos (empty board)", puyo::bench::empty_board);
+	bench_find_combos("find_combos (checkerboard)", puyo::bench::checkerboard);
+	bench_find_combos("find_combos (19-chain board)", puyo::bench::chain_19);
+	bench_find_combos_moved("find_combos (19-chain board, 2 blobs moved)", puyo::bench::chain_19);
+
+	bench_placements("generate_placements (empty board)", puyo::bench::empty_board, puyo::blue);
+	bench_placements("generate_placements (empty board, one colour)", puyo::bench::empty_board, puyo::red);
+	bench_placements("generate_placements (19-chain board)", puyo::bench::chain_19, puyo::blue);
+	bench_resolve_chains();
+	bench_evaluate_placements();
+
+	bench_fall_pieces();
+	bench_settle_pieces();
+	bench_scheduler();
+	bench_render_grid();
+
+	bench_snapshot("coordinator save + restore (empty board)", puyo::bench::empty_board);
+	bench_snapshot("coordinator save + restore (19-chain board)", puyo::bench::chain_19);
+
+	return 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace puyo
+{
+	// Fixed set of workers that cooperatively drain index ranges. The calling thread joins in,
+	// so a pool of n threads keeps n + 1 cores busy until parallel_for returns.
+	class thread_pool final
+	{
+	public:
+		explicit thread_pool(std::size_t threads = default_threads());
+		~thread_pool();
+
+		thread_pool(const thread_pool &) = delete;
+		thread_pool &operator=(const thread_pool &) = delete;
+
+		thread_pool(thread_pool &&) = delete;
+		thread_pool &operator=(thread_pool &&) = delete;
+
+		// Calls func(i) for every i in [0, count), each index exactly once, and blocks until
+		// all of them have returned.
+		template <typename Func>
+		void parallel_for(std::size_t count, Func &&func)
+		{
+			_dispatch(count, &func, [](void *f, std::size_t i) { (*static_cast<std::remove_reference_t<Func> *>(f))(i); });
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return _workers.size();
+		}
+
+		[[nodiscard]] static std::size_t default_threads() noexcept;
+
+	private:
+		using invoke_type = void (*)(void *, std::size_t);
+
+		std::vector<std::thread> _workers;
+
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::condition_variable _done;
+
+		void *_job{ nullptr };
+		invoke_type _invoke{ nullptr };
+		std::size_t _count{ 0 };
+		std::atomic<std::size_t> _next{ 0 };
+		std::size_t _active{ 0 };
+		std::uint64_t _generation{ 0 };
+		bool _stop{ false };
+
+		void _dispatch(std::size_t count, void *job, invoke_type invoke);
+		void _drain();
+		void _worker();
+	};
+}
@@ -1,11 +0,0 @@
-#pragma once
-
-#include "../../core/ecs/entity.hpp"
-
-namespace puyo
-{
-	struct belonging_chain final
-	{
-		entity chain;
-	};
-}
\ No newline at end of file
@@ -1,14 +1,44 @@
 #pragma once
 
-#include <map>
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
-#include "../../core/ecs/entity.hpp"
+#include "../../core/constants.hpp"
+#include "../../core/label_groups.hpp"
 
 namespace puyo
 {
+	// Fixed pool for the groups about to clear. Every group holds at least min_chain_size cells,
+	// so a full board fits; clearing only resets the count.
 	struct chains final
 	{
-		std::map<entity, std::vector<entity>> blob_chains;
+		static constexpr std::size_t capacity{ grid_size / static_cast<std::size_t>(min_chain_size) };
+
+		std::array<color_group, capacity> groups{};
+		std::size_t count{ 0 };
+
+		// Change tick of the last find_combos; only blobs moved since then can start a group.
+		std::uint32_t scanned{ 0 };
+
+		[[nodiscard]] const color_group *begin() const noexcept
+		{
+			return groups.data();
+		}
+
+		[[nodiscard]] const color_group *end() const noexcept
+		{
+			return groups.data() + count;
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return count == 0u;
+		}
+
+		void clear() noexcept
+		{
+			count = 0u;
+		}
 	};
 }
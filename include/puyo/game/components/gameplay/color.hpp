@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace puyo
 {
 	enum color_t
@@ -10,6 +12,8 @@ namespace puyo
 		blue = 0x4
 	};
 
+	inline constexpr std::size_t color_count{ 4 };
+
 	struct color final
 	{
 		color_t blob_color;
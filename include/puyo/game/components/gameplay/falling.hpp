@@ -1,13 +1,45 @@
 #pragma once
 
-#include <vector>
+#include <array>
+#include <cassert>
+#include <cstddef>
 
+#include "../../core/constants.hpp"
 #include "../../core/ecs/entity.hpp"
 
 namespace puyo
 {
+	// Fixed pool of the blobs still falling. A blob is queued at most once per fall, so a full
+	// board fits, and the component stays trivially copyable for snapshots.
 	struct falling final
 	{
-		std::vector<entity> pieces;
+		std::array<entity, grid_size> pieces{};
+		std::size_t count{ 0 };
+
+		void push_back(entity e) noexcept
+		{
+			assert(count < pieces.size() && "Too many falling blobs.");
+			pieces[count++] = e;
+		}
+
+		[[nodiscard]] entity *begin() noexcept
+		{
+			return pieces.data();
+		}
+
+		[[nodiscard]] entity *end() noexcept
+		{
+			return pieces.data() + count;
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return count == 0u;
+		}
+
+		void clear() noexcept
+		{
+			count = 0u;
+		}
 	};
 }
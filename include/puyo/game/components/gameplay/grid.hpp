@@ -1,14 +1,39 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 
+#include "../../core/bitboard.hpp"
 #include "../../core/ecs/entity.hpp"
 #include "../../core/constants.hpp"
+#include "../../core/zobrist.hpp"
+
+#include "color.hpp"
 
 namespace puyo
 {
 	struct grid final
 	{
 		std::array<entity, grid_size> board_blobs;
+		std::array<bitboard, color_count> color_boards{};
+
+		// Zobrist hash of color_boards, kept up to date cell by cell.
+		std::uint64_t hash{ 0 };
 	};
+
+	// Every write to board_blobs goes through these so the per-colour bitboards and the hash
+	// stay in sync.
+	inline void place_blob(grid &g, std::size_t cell, entity e, color_t c) noexcept
+	{
+		g.board_blobs[cell] = e;
+		g.color_boards[c - 1].set(cell);
+		g.hash ^= zobrist::key(cell, c);
+	}
+
+	inline void remove_blob(grid &g, std::size_t cell, color_t c) noexcept
+	{
+		g.board_blobs[cell] = 0u;
+		g.color_boards[c - 1].reset(cell);
+		g.hash ^= zobrist::key(cell, c);
+	}
 }
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace puyo
+{
+	enum class drop_t
+	{
+		none,
+		pressed,
+		released
+	};
+
+	// Player intent for a single tick, decoupled from any input device.
+	struct actions final
+	{
+		bool left{ false };
+		bool right{ false };
+		bool rotate_left{ false };
+		bool rotate_right{ false };
+		drop_t drop{ drop_t::none };
+
+		bool pause{ false };
+		bool restart{ false };
+	};
+}
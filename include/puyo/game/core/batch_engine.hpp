@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "../../common/thread_pool.hpp"
+
+#include "actions.hpp"
+#include "game.hpp"
+#include "headless_engine.hpp"
+
+namespace puyo
+{
+	// Owns N independent headless boards in one contiguous block and steps them in parallel.
+	// Each board is advanced by a single worker for the whole run, so boards never share
+	// state and policies only need to be safe across distinct board indices.
+	template <typename Game = game>
+	class batch_engine
+	{
+	public:
+		using game_type = Game;
+		using board_type = headless_engine<game_type>;
+		using seconds_type = std::chrono::duration<double>;
+
+		explicit batch_engine(std::size_t boards, std::size_t threads = thread_pool::default_threads())
+			: _boards{ std::make_unique<board_type[]>(boards) }
+			, _size{ boards }
+			, _pool{ threads }
+		{
+			// empty
+		}
+
+		void run(std::uint64_t ticks)
+		{
+			_timed(ticks, [&](std::size_t i) { _boards[i].run(ticks); });
+		}
+
+		// Policy is invoked once per board and tick as `actions(std::size_t board, game_type &)`,
+		// concurrently for different boards.
+		template <typename Policy>
+		void run(std::uint64_t ticks, Policy &&policy)
+		{
+			_timed(ticks,
+				[&](std::size_t i)
+				{
+					_boards[i].run(ticks, [&](game_type &g) { return policy(i, g); });
+				}
+			);
+		}
+
+		[[nodiscard]] board_type &operator[](std::size_t i) noexcept
+		{
+			return _boards[i];
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return _size;
+		}
+
+		[[nodiscard]] std::size_t threads() const noexcept
+		{
+			return _pool.size() + 1u;
+		}
+
+		// Board·ticks advanced and wall time spent across every run so far.
+		[[nodiscard]] std::uint64_t board_ticks() const noexcept
+		{
+			return _board_ticks;
+		}
+
+		[[nodiscard]] seconds_type elapsed() const noexcept
+		{
+			return _elapsed;
+		}
+
+		[[nodiscard]] double throughput() const noexcept
+		{
+			return _elapsed.count() > 0.0 ? static_cast<double>(_board_ticks) / _elapsed.count() : 0.0;
+		}
+
+	private:
+		std::unique_ptr<board_type[]> _boards;
+		std::size_t _size;
+		thread_pool _pool;
+
+		std::uint64_t _board_ticks{ 0 };
+		seconds_type _elapsed{ 0.0 };
+
+		template <typename Func>
+		void _timed(std::uint64_t ticks, Func &&func)
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			_pool.parallel_for(_size, func);
+
+			_elapsed += std::chrono::steady_clock::now() - start;
+			_board_ticks += ticks * _size;
+		}
+	};
+}
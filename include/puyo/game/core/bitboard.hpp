@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "constants.hpp"
+
+namespace puyo
+{
+	static_assert(grid_width == 8 && grid_height == 16, "bitboard assumes an 8x16 grid.");
+
+	[[nodiscard]] inline int popcount(std::uint64_t bits) noexcept
+	{
+	#if defined(_MSC_VER)
+		return static_cast<int>(__popcnt64(bits));
+	#else
+		return __builtin_popcountll(bits);
+	#endif
+	}
+
+	[[nodiscard]] inline std::size_t lowest_bit(std::uint64_t bits) noexcept
+	{
+	#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, bits);
+		return index;
+	#else
+		return static_cast<std::size_t>(__builtin_ctzll(bits));
+	#endif
+	}
+
+	// One bit per grid cell, cell `x + y * grid_width` at bit of the same index: rows 0-7 live
+	// in `lo` and rows 8-15 in `hi`, one byte per row.
+	struct bitboard final
+	{
+		std::uint64_t lo{ 0 };
+		std::uint64_t hi{ 0 };
+
+		[[nodiscard]] bool test(std::size_t cell) const noexcept
+		{
+			return ((cell < 64u ? lo >> cell : hi >> (cell - 64u)) & 1u) != 0u;
+		}
+
+		void set(std::size_t cell) noexcept
+		{
+			(cell < 64u ? lo : hi) |= std::uint64_t{ 1 } << (cell & 63u);
+		}
+
+		void reset(std::size_t cell) noexcept
+		{
+			(cell < 64u ? lo : hi) &= ~(std::uint64_t{ 1 } << (cell & 63u));
+		}
+
+		[[nodiscard]] bool any() const noexcept
+		{
+			return (lo | hi) != 0u;
+		}
+
+		[[nodiscard]] int count() const noexcept
+		{
+			return popcount(lo) + popcount(hi);
+		}
+
+		// Index of the lowest set cell; the board must not be empty.
+		[[nodiscard]] std::size_t first() const noexcept
+		{
+			return lo != 0u ? lowest_bit(lo) : 64u + lowest_bit(hi);
+		}
+
+		// Just the lowest set cell.
+		[[nodiscard]] bitboard lowest() const noexcept
+		{
+			return lo != 0u ? bitboard{ lo & (~lo + 1u), 0u } : bitboard{ 0u, hi & (~hi + 1u) };
+		}
+
+		// Calls func(cell) for every set cell in ascending order.
+		template <typename Func>
+		void for_each(Func &&func) const
+		{
+			for (std::uint64_t bits = lo; bits != 0u; bits &= bits - 1u)
+				func(lowest_bit(bits));
+
+			for (std::uint64_t bits = hi; bits != 0u; bits &= bits - 1u)
+				func(64u + lowest_bit(bits));
+		}
+
+		[[nodiscard]] friend bitboard operator&(const bitboard &a, const bitboard &b) noexcept
+		{
+			return { a.lo & b.lo, a.hi & b.hi };
+		}
+
+		[[nodiscard]] friend bitboard operator|(const bitboard &a, const bitboard &b) noexcept
+		{
+			return { a.lo | b.lo, a.hi | b.hi };
+		}
+
+		[[nodiscard]] friend bitboard operator^(const bitboard &a, const bitboard &b) noexcept
+		{
+			return { a.lo ^ b.lo, a.hi ^ b.hi };
+		}
+
+		[[nodiscard]] friend bitboard operator~(const bitboard &a) noexcept
+		{
+			return { ~a.lo, ~a.hi };
+		}
+
+		bitboard &operator&=(const bitboard &other) noexcept
+		{
+			lo &= other.lo;
+			hi &= other.hi;
+			return *this;
+		}
+
+		bitboard &operator|=(const bitboard &other) noexcept
+		{
+			lo |= other.lo;
+			hi |= other.hi;
+			return *this;
+		}
+
+		[[nodiscard]] friend bool operator==(const bitboard &a, const bitboard &b) noexcept
+		{
+			return a.lo == b.lo && a.hi == b.hi;
+		}
+
+		[[nodiscard]] friend bool operator!=(const bitboard &a, const bitboard &b) noexcept
+		{
+			return !(a == b);
+		}
+	};
+
+	namespace bitboards
+	{
+		inline constexpr std::uint64_t column_0{ 0x0101010101010101u };
+		inline constexpr std::uint64_t column_7{ 0x8080808080808080u };
+
+		// Every cell shifted one row up/down or one column left/right; cells pushed off the
+		// board are dropped rather than wrapped into the neighbouring row.
+		[[nodiscard]] inline bitboard shift_up(const bitboard &b) noexcept
+		{
+			return { (b.lo >> 8) | (b.hi << 56), b.hi >> 8 };
+		}
+
+		[[nodiscard]] inline bitboard shift_down(const bitboard &b) noexcept
+		{
+			return { b.lo << 8, (b.hi << 8) | (b.lo >> 56) };
+		}
+
+		[[nodiscard]] inline bitboard shift_left(const bitboard &b) noexcept
+		{
+			return { ((b.lo >> 1) | (b.hi << 63)) & ~column_7, (b.hi >> 1) & ~column_7 };
+		}
+
+		[[nodiscard]] inline bitboard shift_right(const bitboard &b) noexcept
+		{
+			return { (b.lo << 1) & ~column_0, ((b.hi << 1) | (b.lo >> 63)) & ~column_0 };
+		}
+
+		// Cells in `b` plus their orthogonal neighbours.
+		[[nodiscard]] inline bitboard dilate(const bitboard &b) noexcept
+		{
+			return b | shift_up(b) | shift_down(b) | shift_left(b) | shift_right(b);
+		}
+
+		// Connected component of `within` containing `seed`, grown one ring per iteration.
+		[[nodiscard]] inline bitboard flood_fill(bitboard seed, const bitboard &within) noexcept
+		{
+			for (bitboard next = dilate(seed) & within; next != seed; next = dilate(seed) & within)
+				seed = next;
+
+			return seed;
+		}
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "../components/gameplay/color.hpp"
+
+#include "bitboard.hpp"
+#include "constants.hpp"
+#include "label_groups.hpp"
+#include "move_generator.hpp"
+
+namespace puyo
+{
+	// The board a chain settles into, how many steps cleared something, and the score they
+	// earned, counted as clear_chains counts it.
+	struct chain_result final
+	{
+		std::array<bitboard, color_count> boards;
+		int chains;
+		int score;
+	};
+
+	namespace detail
+	{
+		// Every cell shifted `rows` rows up; `rows` is below grid_height.
+		[[nodiscard]] inline bitboard shift_up_rows(const bitboard &b, std::size_t rows) noexcept
+		{
+			const std::size_t bits = rows * grid_width;
+
+			if (bits == 0u)
+				return b;
+			if (bits >= 64u)
+				return { b.hi >> (bits - 64u), 0u };
+
+			return { (b.lo >> bits) | (b.hi << (64u - bits)), b.hi >> bits };
+		}
+
+		// Drops every blob onto whatever is below it and returns the cells that moved, where they
+		// ended up. Each round moves everything with a hole anywhere beneath it down one row, so
+		// the rounds needed are the deepest hole, not the tallest stack.
+		inline bitboard settle(std::array<bitboard, color_count> &boards) noexcept
+		{
+			bitboard moved{};
+
+			for (;;)
+			{
+				const bitboard occupied = boards[0] | boards[1] | boards[2] | boards[3];
+
+				// Cells with a hole somewhere below them in their column.
+				bitboard holes = bitboards::shift_up(~occupied);
+				holes |= shift_up_rows(holes, 1u);
+				holes |= shift_up_rows(holes, 2u);
+				holes |= shift_up_rows(holes, 4u);
+				holes |= shift_up_rows(holes, 8u);
+
+				const bitboard falling = occupied & holes;
+
+				if (!falling.any())
+					return moved;
+
+				for (auto &board : boards)
+					board = (board & ~falling) | bitboards::shift_down(board & falling);
+
+				moved = (moved & ~falling) | bitboards::shift_down(falling);
+			}
+		}
+	}
+
+	// Runs a board to rest: clears every group of at least min_chain_size, drops what is left
+	// and repeats until nothing clears. Groups can only start from `touching`, the cells that
+	// last moved, as in find_combos, so the board must hold no group that would clear without
+	// them. Within a step the multiplier starts at 10 and goes up by 10 per group, groups in
+	// order of their lowest cell, exactly as clear_chains scores them.
+	[[nodiscard]] inline chain_result resolve_chains(const std::array<bitboard, color_count> &boards, bitboard touching = ~bitboard{}) noexcept
+	{
+		chain_result result{ boards, 0, 0 };
+		std::array<color_group, grid_size / static_cast<std::size_t>(min_chain_size)> groups;
+
+		for (;;)
+		{
+			const std::size_t count = label_groups(result.boards, touching, min_chain_size, groups.data());
+
+			if (count == 0u)
+				return result;
+
+			int multiplier = 10;
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				result.boards[groups[i].color - 1] &= ~groups[i].cells;
+				result.score += multiplier * groups[i].size;
+				multiplier += 10;
+			}
+
+			++result.chains;
+			touching = detail::settle(result.boards);
+		}
+	}
+
+	// Drops a placement and runs the chain it sets off.
+	[[nodiscard]] inline chain_result resolve_chains(const placement &p) noexcept
+	{
+		bitboard placed{};
+		placed.set(p.center_cell);
+		placed.set(p.other_cell);
+
+		return resolve_chains(p.boards, placed);
+	}
+}
@@ -17,6 +17,8 @@ namespace puyo
 	inline constexpr std::size_t grid_height{ 16 };
 	inline constexpr std::size_t grid_size{ grid_width * grid_height };
 
+	inline constexpr int min_chain_size{ 4 };
+
 	template <typename T = int>
 	inline constexpr T x_interval{ logical_width<T> / grid_width };
 
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "component.hpp"
+#include "signature.hpp"
+
+namespace puyo
+{
+	template <typename... Ts>
+	struct reads final
+	{
+		// empty
+	};
+
+	template <typename... Ts>
+	struct writes final
+	{
+		// empty
+	};
+
+	template <typename Reads, typename Writes, bool Exclusive = false>
+	struct access;
+
+	// Components a system reads and writes, as signatures. Exclusive systems touch the
+	// coordinator itself (creating or destroying entities directly, registering views,
+	// advancing the change tick) and so conflict with every other system.
+	template <typename... R, typename... W, bool Exclusive>
+	struct access<reads<R...>, writes<W...>, Exclusive> final
+	{
+		[[nodiscard]] static signature read_signature() noexcept
+		{
+			signature sig{};
+			(sig.set(component_type_of<R>()), ...);
+			return sig;
+		}
+
+		[[nodiscard]] static signature write_signature() noexcept
+		{
+			signature sig{};
+
+			if constexpr (Exclusive)
+				sig.set();
+			else
+				(sig.set(component_type_of<W>()), ...);
+
+			return sig;
+		}
+	};
+
+	using exclusive_access = access<reads<>, writes<>, true>;
+}
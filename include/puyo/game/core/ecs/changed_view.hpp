@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "component_array.hpp"
+#include "entity.hpp"
+
+namespace puyo
+{
+	// Entities whose T was added or patched after change tick `since`, in the array's dense order.
+	template <typename T>
+	class changed_view final
+	{
+	public:
+		changed_view(component_array<T> &array, std::uint32_t since) noexcept
+			: _array{ array }
+			, _since{ since }
+		{
+			// empty
+		}
+
+		template <typename Func>
+		void each(Func &&func)
+		{
+			const entity *ids = _array.entities();
+			T *data = _array.data();
+
+			for (std::size_t i = 0, size = _array.size(); i < size; ++i)
+			{
+				if (_array.changed_since(ids[i], _since))
+					func(ids[i], data[i]);
+			}
+		}
+
+	private:
+		component_array<T> &_array;
+		std::uint32_t _since;
+	};
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "component.hpp"
+#include "coordinator.hpp"
+#include "entity.hpp"
+
+namespace puyo
+{
+	namespace detail
+	{
+		class command_pool_base
+		{
+		public:
+			virtual ~command_pool_base() = default;
+			virtual void flush_adds(coordinator &, const entity *) = 0;
+			virtual void flush_removes(coordinator &, const entity *) = 0;
+			virtual void clear() noexcept = 0;
+		};
+
+		// Handles at or past max_entities stand for entities the buffer creates on flush.
+		[[nodiscard]] inline entity resolve(entity id, const entity *created) noexcept
+		{
+			const entity index = entity_index(id);
+			return index >= max_entities ? created[index - max_entities] : id;
+		}
+
+		template <typename T>
+		class command_pool final : public command_pool_base
+		{
+		public:
+			void add(entity id, T component)
+			{
+				_adds.emplace_back(id, std::move(component));
+			}
+
+			void remove(entity id)
+			{
+				_removes.push_back(id);
+			}
+
+			void flush_adds(coordinator &coord, const entity *created) override
+			{
+				for (auto &[id, component] : _adds)
+					coord.add_component<T>(resolve(id, created), std::move(component));
+			}
+
+			void flush_removes(coordinator &coord, const entity *created) override
+			{
+				for (entity id : _removes)
+					coord.remove_component<T>(resolve(id, created));
+			}
+
+			void clear() noexcept override
+			{
+				_adds.clear();
+				_removes.clear();
+			}
+
+		private:
+			std::vector<std::pair<entity, T>> _adds;
+			std::vector<entity> _removes;
+		};
+	}
+
+	// Structural changes recorded while systems iterate and applied together by flush(). Each
+	// kind of change is applied as one batch: creations first, then additions one component
+	// type at a time, then removals, then every destruction through destroy_entities. Buffers
+	// keep their storage between flushes, and one buffer per thread lets systems record in
+	// parallel.
+	class command_buffer final
+	{
+	public:
+		// Placeholder for an entity created on flush; only meaningful to this buffer.
+		[[nodiscard]] entity create()
+		{
+			assert(max_entities + _creates <= entity_index_mask && "Too many pending creations.");
+			return make_entity(max_entities + _creates++, 0u);
+		}
+
+		void destroy(entity id)
+		{
+			_destroys.push_back(id);
+		}
+
+		template <typename T>
+		void add_component(entity id, T component)
+		{
+			_pool<T>().add(id, std::move(component));
+		}
+
+		template <typename T>
+		void remove_component(entity id)
+		{
+			_pool<T>().remove(id);
+		}
+
+		void flush(coordinator &coord)
+		{
+			_created.resize(_creates);
+
+			for (auto &id : _created)
+				id = coord.create_entity();
+
+			for (auto &pool : _pools)
+			{
+				if (pool)
+					pool->flush_adds(coord, _created.data());
+			}
+
+			for (auto &pool : _pools)
+			{
+				if (pool)
+					pool->flush_removes(coord, _created.data());
+			}
+
+			for (auto &id : _destroys)
+				id = detail::resolve(id, _created.data());
+
+			std::sort(_destroys.begin(), _destroys.end());
+			coord.destroy_entities(_destroys.data(), _destroys.size());
+
+			clear();
+		}
+
+		void clear() noexcept
+		{
+			for (auto &pool : _pools)
+			{
+				if (pool)
+					pool->clear();
+			}
+
+			_destroys.clear();
+			_creates = 0u;
+		}
+
+	private:
+		std::array<std::unique_ptr<detail::command_pool_base>, max_components> _pools{};
+		std::vector<entity> _destroys;
+		std::vector<entity> _created;
+		entity _creates{ 0 };
+
+		template <typename T>
+		detail::command_pool<T> &_pool()
+		{
+			auto &pool = _pools[component_type_of<T>()];
+
+			if (!pool)
+				pool = std::make_unique<detail::command_pool<T>>();
+
+			return static_cast<detail::command_pool<T> &>(*pool);
+		}
+	};
+}
@@ -1,9 +1,28 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 
 namespace puyo
 {
 	using component_type = std::uint8_t;
 	constexpr const component_type max_components = 32u;
+
+	namespace detail
+	{
+		[[nodiscard]] inline component_type next_component_type() noexcept
+		{
+			static std::atomic<component_type> next{ 0u };
+			return next.fetch_add(1u, std::memory_order_relaxed);
+		}
+	}
+
+	// Dense per-type id, assigned once per process on first use and shared by every
+	// component_manager, so it doubles as the component's bit in a signature.
+	template <typename T>
+	[[nodiscard]] component_type component_type_of() noexcept
+	{
+		static const component_type type = detail::next_component_type();
+		return type;
+	}
 }
@@ -1,10 +1,15 @@
 #pragma once
 
-#include <array>
+#include <algorithm>
 #include <cassert>
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 #include "entity.hpp"
+#include "entity_set.hpp"
+#include "snapshot.hpp"
 
 namespace puyo
 {
@@ -13,58 +18,183 @@ namespace puyo
 	public:
 		virtual ~component_array_base() = default;
 		virtual void entity_destroyed(entity) = 0;
+		virtual void entities_destroyed(const entity *, std::size_t) = 0;
+
+		// Exchanges two slots, entity and component alike; used to keep owning groups packed.
+		virtual void swap_slots(std::size_t, std::size_t) = 0;
+
+		// Bytes held by this array and its index, excluding heap memory owned by the components.
+		[[nodiscard]] virtual std::size_t memory() const noexcept = 0;
+
+		// Removes every component, keeping the storage and whether changes are tracked.
+		virtual void clear() noexcept = 0;
+
+		virtual void save(snapshot &) const = 0;
+		virtual void restore(snapshot_reader &) = 0;
+
+		[[nodiscard]] bool contains(entity id) const noexcept
+		{
+			return _entities.contains(id);
+		}
+
+		[[nodiscard]] std::size_t index_of(entity id) const noexcept
+		{
+			return _entities.index_of(id);
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return _entities.size();
+		}
+
+		[[nodiscard]] const entity *entities() const noexcept
+		{
+			return _entities.data();
+		}
+
+		// Change tracking is opt-in. Once on, the tick of each entity's last change is kept by
+		// entity index, so it survives the slot moves of removal and owning groups.
+		void track_changes()
+		{
+			_changed.resize(max_entities);
+		}
+
+		void mark_changed(entity id, std::uint32_t tick) noexcept
+		{
+			if (!_changed.empty())
+				_changed[entity_index(id)] = tick;
+		}
+
+		[[nodiscard]] bool changed_since(entity id, std::uint32_t tick) const noexcept
+		{
+			assert(!_changed.empty() && "Querying changes of an untracked component.");
+			return _changed[entity_index(id)] > tick;
+		}
+
+	protected:
+		entity_set _entities{};
+		std::vector<std::uint32_t> _changed;
+
+		[[nodiscard]] std::size_t _index_memory() const noexcept
+		{
+			return _entities.memory() + _changed.capacity() * sizeof(std::uint32_t);
+		}
+
+		void _clear_index() noexcept
+		{
+			_entities.clear();
+			std::fill(_changed.begin(), _changed.end(), 0u);
+		}
+
+		// Whether changes are tracked is configuration and must match; only the ticks are restored.
+		void _save_index(snapshot &snap) const
+		{
+			_entities.save(snap);
+			snap.write(_changed.size());
+			snap.write(_changed.data(), _changed.size());
+		}
+
+		void _restore_index(snapshot_reader &reader)
+		{
+			_entities.restore(reader);
+
+			[[maybe_unused]] const auto tracked = reader.read<std::size_t>();
+			assert(tracked == _changed.size() && "Restoring changes of a component tracked differently.");
+
+			reader.read(_changed.data(), _changed.size());
+		}
 	};
 
+	// Components are packed in the same order as the owning entities in `_entities`, so
+	// removal mirrors the set's swap with the last slot. Storage grows to the most components
+	// held at once and keeps its capacity, so singletons cost one slot rather than max_entities.
 	template <typename T>
 	class component_array : public component_array_base
 	{
 	public:
 		void insert_data(entity id, T component)
 		{
-			// assert(_entity_to_index.find(id) == _entity_to_index.end() && "Component added to same entity more than once.");
-
-			std::size_t new_index = _size;
-			_entity_to_index[id] = new_index;
-			_index_to_entity[new_index] = id;
-			_component_array[new_index] = component;
-			++_size;
+			_entities.insert(id);
+			_component_array.push_back(std::move(component));
 		}
 
 		void remove_data(entity id)
 		{
-			// assert(_entity_to_index.find(id) != _entity_to_index.end() && "Removing non-existent component.");
+			const std::size_t last = _entities.size() - 1u;
+			const std::size_t removed = _entities.erase(id);
 
-			std::size_t removed = _entity_to_index[id];
-			std::size_t last = _size - 1;
-			_component_array[removed] = _component_array[last];
+			if (removed != last)
+				_component_array[removed] = std::move(_component_array[last]);
 
-			entity entity_last = _index_to_entity[last];
-			_entity_to_index[entity_last] = removed;
-			_index_to_entity[removed] = entity_last;
+			_component_array.pop_back();
+		}
 
-			_entity_to_index.erase(id);
-			_index_to_entity.erase(last);
+		[[nodiscard]] T &get_data(entity id)
+		{
+			return _component_array[_entities.index_of(id)];
+		}
 
-			--_size;
+		[[nodiscard]] const T &get_data(entity id) const
+		{
+			return _component_array[_entities.index_of(id)];
 		}
 
-		[[nodiscard]] T &get_data(entity id)
+		[[nodiscard]] T *data() noexcept
 		{
-			// assert(_entity_to_index.find(id) != _entity_to_index.end() && "Retrieving non-existent component.");
+			return _component_array.data();
+		}
 
-			return _component_array[_entity_to_index[id]];
+		// Only called for entities whose signature names this array.
+		void entity_destroyed(entity id) override
+		{
+			remove_data(id);
+		}
+
+		// Called once per batch for every array any entity in it owns, so skips the rest.
+		void entities_destroyed(const entity *ids, std::size_t count) override
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (contains(ids[i]))
+					remove_data(ids[i]);
+			}
+		}
+
+		void swap_slots(std::size_t a, std::size_t b) override
+		{
+			if (a == b)
+				return;
+
+			using std::swap;
+			swap(_component_array[a], _component_array[b]);
+			_entities.swap(static_cast<entity_set::index_type>(a), static_cast<entity_set::index_type>(b));
+		}
+
+		[[nodiscard]] std::size_t memory() const noexcept override
+		{
+			return sizeof(*this) + _index_memory() + _component_array.capacity() * sizeof(T);
+		}
+
+		void clear() noexcept override
+		{
+			_clear_index();
+			_component_array.clear();
+		}
+
+		void save(snapshot &snap) const override
+		{
+			_save_index(snap);
+			snap.write(_component_array.data(), _component_array.size());
 		}
 
-		void entity_destroyed(entity id)
+		void restore(snapshot_reader &reader) override
 		{
-			if (_entity_to_index.find(id) != _entity_to_index.end())
-				remove_data(id);
+			_restore_index(reader);
+			_component_array.resize(_entities.size());
+			reader.read(_component_array.data(), _component_array.size());
 		}
 
 	protected:
-		std::array<T, max_entities> _component_array{};
-		std::unordered_map<entity, std::size_t> _entity_to_index;
-		std::unordered_map<std::size_t, entity> _index_to_entity;
-		std::size_t _size;
+		std::vector<T> _component_array;
 	};
 }
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <memory>
-#include <typeinfo>
-#include <unordered_map>
+#include <utility>
 
 #include "component.hpp"
 #include "component_array.hpp"
 #include "entity.hpp"
+#include "signature.hpp"
+#include "snapshot.hpp"
 
 namespace puyo
 {
@@ -17,64 +20,132 @@ namespace puyo
 		template <typename T>
 		void register_component()
 		{
-			const char *type_name = typeid(T).name();
+			const component_type type = component_type_of<T>();
 
-			assert(_component_types.find(type_name) == _component_types.end() && "Registering component type more than once.");
+			assert(type < max_components && "Too many component types.");
+			assert(_component_arrays[type] == nullptr && "Registering component type more than once.");
 
-			_component_types.insert({ type_name, _next_component_type });
-			_component_arrays.insert({ type_name, std::make_shared<component_array<T>>() });
-
-			++_next_component_type;
+			_component_arrays[type] = std::make_unique<component_array<T>>();
 		}
 
 		template <typename T>
-		[[nodiscard]] component_type get_component_type()
+		[[nodiscard]] component_type get_component_type() const
 		{
-			const char *type_name = typeid(T).name();
-			assert(_component_types.find(type_name) != _component_types.end() && "Component not registered before use.");
-			return _component_types[type_name];
+			const component_type type = component_type_of<T>();
+			assert(_component_arrays[type] != nullptr && "Component not registered before use.");
+			return type;
 		}
 
 		template <typename T>
 		void add_component(entity id, T component)
 		{
-			_get_component_array<T>()->insert_data(id, component);
+			get_component_array<T>().insert_data(id, std::move(component));
 		}
 
 		template <typename T>
 		void remove_component(entity id)
 		{
-			_get_component_array<T>()->remove_data(id);
+			get_component_array<T>().remove_data(id);
 		}
 
 		template <typename T>
 		[[nodiscard]] T &get_component(entity id)
 		{
-			return _get_component_array<T>()->get_data(id);
+			return get_component_array<T>().get_data(id);
+		}
+
+		template <typename T>
+		[[nodiscard]] const T &get_component(entity id) const
+		{
+			return get_component_array<T>().get_data(id);
+		}
+
+		template <typename T>
+		[[nodiscard]] component_array<T> &get_component_array()
+		{
+			return static_cast<component_array<T> &>(*_component_arrays[get_component_type<T>()]);
+		}
+
+		template <typename T>
+		[[nodiscard]] const component_array<T> &get_component_array() const
+		{
+			return static_cast<const component_array<T> &>(*_component_arrays[get_component_type<T>()]);
+		}
+
+		[[nodiscard]] component_array_base &get_component_array(component_type type)
+		{
+			assert(_component_arrays[type] != nullptr && "Component not registered before use.");
+			return *_component_arrays[type];
 		}
 
-		void entity_destroyed(entity id)
+		// `sig` is the entity's signature from before destruction; only arrays it names are visited.
+		void entity_destroyed(entity id, signature sig)
 		{
-			for (auto const &pair : _component_arrays)
+			unsigned long bits = sig.to_ulong();
+
+			for (component_type type = 0; bits != 0u; ++type, bits >>= 1u)
 			{
-				auto const &component = pair.second;
-				component->entity_destroyed(id);
+				if (bits & 1u)
+					_component_arrays[type]->entity_destroyed(id);
 			}
 		}
 
-	private:
-		std::unordered_map<const char *, component_type> _component_types{};
-		std::unordered_map<const char *, std::shared_ptr<component_array_base>> _component_arrays{};
+		// `owned` is the union of the entities' signatures.
+		void entities_destroyed(const entity *ids, std::size_t count, signature owned)
+		{
+			unsigned long bits = owned.to_ulong();
+
+			for (component_type type = 0; bits != 0u; ++type, bits >>= 1u)
+			{
+				if (bits & 1u)
+					_component_arrays[type]->entities_destroyed(ids, count);
+			}
+		}
 
-		component_type _next_component_type{};
+		// Bytes held by every registered array, the table of arrays included.
+		[[nodiscard]] std::size_t memory() const noexcept
+		{
+			std::size_t bytes = sizeof(*this);
 
-		template <typename T>
-		std::shared_ptr<component_array<T>> _get_component_array()
+			for (const auto &array : _component_arrays)
+			{
+				if (array != nullptr)
+					bytes += array->memory();
+			}
+
+			return bytes;
+		}
+
+		void clear() noexcept
+		{
+			for (const auto &array : _component_arrays)
+			{
+				if (array != nullptr)
+					array->clear();
+			}
+		}
+
+		// Arrays are written in type order, so a snapshot restores into any component_manager
+		// with the same types registered.
+		void save(snapshot &snap) const
 		{
-			const char *type_name = typeid(T).name();
-			assert(_component_types.find(type_name) != _component_types.end() && "Component not registered before use.");
-			
-			return std::static_pointer_cast<component_array<T>>(_component_arrays[type_name]);
+			for (const auto &array : _component_arrays)
+			{
+				if (array != nullptr)
+					array->save(snap);
+			}
 		}
+
+		void restore(snapshot_reader &reader)
+		{
+			for (const auto &array : _component_arrays)
+			{
+				if (array != nullptr)
+					array->restore(reader);
+			}
+		}
+
+	private:
+		std::array<std::unique_ptr<component_array_base>, max_components> _component_arrays{};
 	};
 }
@@ -1,20 +1,40 @@
 #pragma once
 
-#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
 
+#include "changed_view.hpp"
 #include "component_manager.hpp"
+#include "entity_group.hpp"
 #include "entity_manager.hpp"
+#include "entity_view.hpp"
+#include "group_manager.hpp"
+#include "prefab.hpp"
+#include "snapshot.hpp"
+#include "system_manager.hpp"
 
 namespace puyo
 {
-	class coordinator final
+	// Bytes held by a coordinator: entity slots and signatures, component arrays with their
+	// indices, and the system views and groups. Heap memory owned by components is not included.
+	struct memory_usage final
 	{
-	public:
-		coordinator()
+		std::size_t entities;
+		std::size_t components;
+		std::size_t views;
+
+		[[nodiscard]] std::size_t total() const noexcept
 		{
-			_component_manager = std::make_unique<component_manager>();
-			_entity_manager = std::make_unique<entity_manager>();
+			return entities + components + views;
 		}
+	};
+
+	class coordinator final
+	{
+	public:
+		coordinator() = default;
 
 		~coordinator() = default;
 
@@ -26,49 +46,276 @@ namespace puyo
 
 		[[nodiscard]] entity create_entity()
 		{
-			return _entity_manager->create_entity();
+			return _entity_manager.create_entity();
 		}
 
+		// Null and stale handles are ignored, so callers may destroy a handle they are unsure of.
 		void destroy_entity(entity id)
 		{
-			_entity_manager->destroy_entity(id);
-			_component_manager->entity_destroyed(id);
+			if (!_entity_manager.alive(id))
+				return;
+
+			const signature sig = _entity_manager.get_signature(id);
+
+			_group_manager.entity_signature_changed(id, sig, {});
+			_component_manager.entity_destroyed(id, sig);
+			_system_manager.entity_destroyed(id, sig);
+			_entity_manager.destroy_entity(id);
+		}
+
+		// Destroys `count` entities, visiting each component array they own once for the whole
+		// batch. Null, stale and repeated handles are skipped as in destroy_entity.
+		void destroy_entities(const entity *ids, std::size_t count)
+		{
+			signature owned{};
+
+			// Signatures are cleared as entities are unlinked, so repeated handles unlink once.
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (!_entity_manager.alive(ids[i]))
+					continue;
+
+				const signature sig = _entity_manager.get_signature(ids[i]);
+
+				_group_manager.entity_signature_changed(ids[i], sig, {});
+				_system_manager.entity_destroyed(ids[i], sig);
+				_entity_manager.set_signature(ids[i], {});
+
+				owned |= sig;
+			}
+
+			_component_manager.entities_destroyed(ids, count, owned);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (_entity_manager.alive(ids[i]))
+					_entity_manager.destroy_entity(ids[i]);
+			}
+		}
+
+		// Destroys every entity in bulk: the slot table, component arrays, views and groups are
+		// emptied without visiting entities one by one. Registered components, change tracking,
+		// views and groups stay, and so does the change tick, so consumers' ticks remain valid.
+		void clear() noexcept
+		{
+			_entity_manager.clear();
+			_component_manager.clear();
+			_system_manager.clear();
+			_group_manager.clear();
+		}
+
+		[[nodiscard]] bool alive(entity id) const noexcept
+		{
+			return _entity_manager.alive(id);
 		}
 
 		template <typename T>
 		void register_component()
 		{
-			_component_manager->register_component<T>();
+			_component_manager.register_component<T>();
 		}
 
 		template <typename T>
 		void add_component(entity id, T component)
 		{
-			_component_manager->add_component<T>(id, component);
+			add_components<T>(id, std::move(component));
+		}
+
+		// Adds several components with a single signature update, so an entity joins views and
+		// groups once rather than once per component.
+		template <typename... Ts>
+		void add_components(entity id, Ts... components)
+		{
+			(_component_manager.add_component<Ts>(id, std::move(components)), ...);
+			(_component_manager.get_component_array<Ts>().mark_changed(id, _change_tick), ...);
 
-			auto sig = _entity_manager->get_signature(id);
-			sig.set(_component_manager->get_component_type<T>(), true);
-			_entity_manager->set_signature(id, sig);
+			const signature before = _entity_manager.get_signature(id);
+			signature after = before;
+			(after.set(_component_manager.get_component_type<Ts>()), ...);
+			_entity_manager.set_signature(id, after);
+
+			_system_manager.entity_signature_changed(id, after);
+			_group_manager.entity_signature_changed(id, before, after);
+		}
+
+		// Creates `count` entities from `p`, each holding a copy of its components, and writes
+		// them to `out`. customise(i, components...) adjusts the i-th entity's copies before they
+		// are stored. The arrays are looked up once per batch and each entity takes a single
+		// signature write.
+		template <typename... Ts, typename Func>
+		void instantiate(const prefab<Ts...> &p, entity *out, std::size_t count, Func &&customise)
+		{
+			const signature sig = p.get_signature();
+			const std::tuple<component_array<Ts> *...> arrays{ &_component_manager.get_component_array<Ts>()... };
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const entity id = _entity_manager.create_entity();
+				std::tuple<Ts...> components = p.components();
+
+				std::apply([&](Ts &...cs) { customise(i, cs...); }, components);
+				std::apply([&](Ts &...cs) { (std::get<component_array<Ts> *>(arrays)->insert_data(id, std::move(cs)), ...); }, components);
+				(std::get<component_array<Ts> *>(arrays)->mark_changed(id, _change_tick), ...);
+
+				_entity_manager.set_signature(id, sig);
+				_system_manager.entity_signature_changed(id, sig);
+				_group_manager.entity_signature_changed(id, {}, sig);
+
+				out[i] = id;
+			}
+		}
+
+		template <typename... Ts>
+		void instantiate(const prefab<Ts...> &p, entity *out, std::size_t count)
+		{
+			instantiate(p, out, count, [](std::size_t, Ts &...) { /* empty */ });
+		}
+
+		template <typename... Ts>
+		[[nodiscard]] entity instantiate(const prefab<Ts...> &p)
+		{
+			entity id;
+			instantiate(p, &id, 1u);
+			return id;
 		}
 
 		template <typename T>
 		void remove_component(entity id)
 		{
-			_component_manager->remove_component<T>(id);
+			const signature before = _entity_manager.get_signature(id);
+			signature after = before;
+			after.set(_component_manager.get_component_type<T>(), false);
+
+			_group_manager.entity_signature_changed(id, before, after);
+			_component_manager.remove_component<T>(id);
 
-			auto sig = _entity_manager->get_signature(id);
-			sig.set(_component_manager->get_component_type<T>(), false);
-			_entity_manager->set_signature(id, sig);
+			_entity_manager.set_signature(id, after);
+			_system_manager.entity_signature_changed(id, after);
 		}
 
 		template <typename T>
 		[[nodiscard]] T &get_component(entity id)
 		{
-			return _component_manager->get_component<T>(id);
+			return _component_manager.get_component<T>(id);
+		}
+
+		template <typename T>
+		[[nodiscard]] const T &get_component(entity id) const
+		{
+			return _component_manager.get_component<T>(id);
+		}
+
+		// Opts T into change tracking: from now on add_component and patch stamp entities with
+		// the current change tick.
+		template <typename T>
+		void track_changes()
+		{
+			_component_manager.get_component_array<T>().track_changes();
+		}
+
+		// get_component for writing; marks the component changed when T is tracked.
+		template <typename T>
+		[[nodiscard]] T &patch(entity id)
+		{
+			auto &array = _component_manager.get_component_array<T>();
+			array.mark_changed(id, _change_tick);
+			return array.get_data(id);
+		}
+
+		// Closes the current change tick and returns it. A consumer keeps the value and passes
+		// it to changed() on its next run, which then sees exactly the changes made in between.
+		[[nodiscard]] std::uint32_t advance_change_tick() noexcept
+		{
+			return _change_tick++;
+		}
+
+		template <typename T>
+		[[nodiscard]] changed_view<T> changed(std::uint32_t since)
+		{
+			return { _component_manager.get_component_array<T>(), since };
+		}
+
+		// The entity set behind a signature is built on first use and kept up to date by
+		// add_component/remove_component/destroy_entity from then on.
+		template <typename... Ts>
+		[[nodiscard]] entity_view<Ts...> view()
+		{
+			signature sig{};
+			(sig.set(_component_manager.get_component_type<Ts>()), ...);
+
+			const entity_set *entities = _system_manager.find(sig);
+
+			if (entities == nullptr)
+				entities = &_system_manager.register_signature(sig, _entity_manager);
+
+			return { *entities, _component_manager.get_component_array<Ts>()... };
+		}
+
+		// Owning group over Ts, built on first use: the owned arrays keep the group's entities
+		// packed at their front from then on. Each component type can be owned by one group.
+		template <typename... Ts>
+		[[nodiscard]] entity_group<Ts...> group()
+		{
+			signature sig{};
+			(sig.set(_component_manager.get_component_type<Ts>()), ...);
+
+			const std::size_t *size = _group_manager.find(sig);
+
+			if (size == nullptr)
+			{
+				component_array_base *const arrays[] = { &_component_manager.get_component_array<Ts>()... };
+				size = &_group_manager.register_group(sig, arrays, sizeof...(Ts), _entity_manager);
+			}
+
+			return { *size, _component_manager.get_component_array<Ts>()... };
+		}
+
+		// What this coordinator holds, by part, for sizing pools of resident boards.
+		[[nodiscard]] memory_usage memory() const noexcept
+		{
+			return { sizeof(_entity_manager), _component_manager.memory(), _system_manager.memory() + sizeof(_group_manager) };
+		}
+
+		// Appends the whole world to `snap`. It restores into this coordinator or any other with
+		// the same components registered and tracked; views and groups are matched by signature,
+		// registered if missing and rebuilt if the snapshot lacks them.
+		void save(snapshot &snap) const
+		{
+			_entity_manager.save(snap);
+			_component_manager.save(snap);
+			_system_manager.save(snap);
+			_group_manager.save(snap);
+			snap.write(_change_tick);
+		}
+
+		void restore(snapshot_reader &reader)
+		{
+			_entity_manager.restore(reader);
+			_component_manager.restore(reader);
+			_system_manager.restore(reader, _entity_manager);
+			_group_manager.restore(reader, _entity_manager,
+				[&](signature sig, component_array_base **arrays)
+				{
+					std::size_t count = 0;
+					unsigned long bits = sig.to_ulong();
+
+					for (component_type type = 0; bits != 0u; ++type, bits >>= 1u)
+					{
+						if (bits & 1u)
+							arrays[count++] = &_component_manager.get_component_array(type);
+					}
+
+					return count;
+				}
+			);
+			_change_tick = reader.read<std::uint32_t>();
 		}
 
 	private:
-		std::unique_ptr<component_manager> _component_manager;
-		std::unique_ptr<entity_manager> _entity_manager;
+		component_manager _component_manager{};
+		entity_manager _entity_manager{};
+		system_manager _system_manager{};
+		group_manager _group_manager{};
+		std::uint32_t _change_tick{ 1 };
 	};
 }
@@ -4,6 +4,29 @@
 
 namespace puyo
 {
+	// A handle packs the entity's slot in the low bits and the slot's generation in the high
+	// bits. Destroying an entity bumps its slot's generation, so handles kept past destruction
+	// no longer compare equal to the live one. Slot 0 is never handed out, keeping 0 a null handle.
 	using entity = std::uint32_t;
 	constexpr const entity max_entities = 512u;
+
+	constexpr const std::uint32_t entity_index_bits = 16u;
+	constexpr const entity entity_index_mask = (entity{ 1 } << entity_index_bits) - 1u;
+
+	static_assert(max_entities <= entity_index_mask, "Too many entities for the handle index bits.");
+
+	[[nodiscard]] constexpr entity entity_index(entity id) noexcept
+	{
+		return id & entity_index_mask;
+	}
+
+	[[nodiscard]] constexpr std::uint32_t entity_generation(entity id) noexcept
+	{
+		return id >> entity_index_bits;
+	}
+
+	[[nodiscard]] constexpr entity make_entity(entity index, std::uint32_t generation) noexcept
+	{
+		return (generation << entity_index_bits) | index;
+	}
 }
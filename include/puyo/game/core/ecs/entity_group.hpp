@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+
+#include "component_array.hpp"
+#include "entity.hpp"
+
+namespace puyo
+{
+	// Entities owning every component in Ts, read straight from the front of the owned arrays.
+	// Adding or removing any of Ts, or destroying a member, reorders the group and invalidates
+	// iteration in progress.
+	template <typename T, typename... Ts>
+	class entity_group final
+	{
+	public:
+		using const_iterator = const entity *;
+
+		entity_group(const std::size_t &size, component_array<T> &first, component_array<Ts> &...rest) noexcept
+			: _size{ size }
+			, _arrays{ &first, &rest... }
+		{
+			// empty
+		}
+
+		template <typename Func>
+		void each(Func &&func)
+		{
+			const entity *ids = std::get<0>(_arrays)->entities();
+			const auto data = std::apply([](auto *...arrays) { return std::make_tuple(arrays->data()...); }, _arrays);
+
+			for (std::size_t i = 0; i < _size; ++i)
+				std::apply([&](auto *...columns) { func(ids[i], columns[i]...); }, data);
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return _size;
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return _size == 0u;
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return std::get<0>(_arrays)->entities();
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return begin() + _size;
+		}
+
+	private:
+		const std::size_t &_size;
+		std::tuple<component_array<T> *, component_array<Ts> *...> _arrays;
+	};
+}
@@ -3,20 +3,24 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
-#include <queue>
 
 #include "entity.hpp"
 #include "signature.hpp"
+#include "snapshot.hpp"
 
 namespace puyo
 {
+	// Slots double as an intrusive free list: a live slot holds its entity's handle, a free one
+	// holds the index of the next free slot (0 ends the list) and the generation its next
+	// handle will carry. A free slot's index bits never match its own index, so one compare
+	// tells a live handle from a stale one.
 	class entity_manager final
 	{
 	public:
 		entity_manager()
 		{
 			for (entity e = 1; e < max_entities; ++e)
-				_available_entities.push(e);
+				_slots[e] = e + 1u < max_entities ? e + 1u : 0u;
 		}
 
 		entity_manager(const entity_manager &) = delete;
@@ -27,40 +31,94 @@ namespace puyo
 
 		[[nodiscard]] entity create_entity()
 		{
-			assert(_entity_count < max_entities && "Too many entities in existence.");
+			assert(_free != 0u && "Too many entities in existence.");
 
-			entity id = _available_entities.front();
-			_available_entities.pop();
+			const entity index = _free;
+			_free = entity_index(_slots[index]);
+			_slots[index] = make_entity(index, entity_generation(_slots[index]));
 			++_entity_count;
 
-			return id;
+			return _slots[index];
 		}
 
 		void destroy_entity(entity id)
 		{
-			assert(id < max_entities && "Entity out of range.");
+			assert(alive(id) && "Destroying entity that is not alive.");
 
-			_signatures[id].reset();
+			const entity index = entity_index(id);
 
-			_available_entities.push(id);
+			_signatures[index].reset();
+
+			_slots[index] = make_entity(_free, entity_generation(id) + 1u);
+			_free = index;
 			--_entity_count;
 		}
 
+		[[nodiscard]] bool alive(entity id) const noexcept
+		{
+			const entity index = entity_index(id);
+			return index != 0u && index < max_entities && _slots[index] == id;
+		}
+
 		void set_signature(entity id, signature sig)
 		{
-			assert(id < max_entities && "Entity out of range.");
-			_signatures[id] = sig;
+			assert(alive(id) && "Entity is not alive.");
+			_signatures[entity_index(id)] = sig;
+		}
+
+		[[nodiscard]] signature get_signature(entity id) const
+		{
+			assert(alive(id) && "Entity is not alive.");
+			return _signatures[entity_index(id)];
+		}
+
+		// Destroys every entity in one pass over the slots. Live slots move to their next
+		// generation as in destroy_entity, so handles from before stay dead, and the free list is
+		// rebuilt in slot order.
+		void clear() noexcept
+		{
+			for (entity e = 1; e < max_entities; ++e)
+			{
+				const std::uint32_t generation = entity_generation(_slots[e]) + (entity_index(_slots[e]) == e ? 1u : 0u);
+				_slots[e] = make_entity(e + 1u < max_entities ? e + 1u : 0u, generation);
+			}
+
+			_signatures.fill({});
+			_free = 1u;
+			_entity_count = 0u;
+		}
+
+		// Calls func(id, signature) for every live entity in slot order.
+		template <typename Func>
+		void each(Func &&func) const
+		{
+			for (entity e = 1; e < max_entities; ++e)
+			{
+				if (entity_index(_slots[e]) == e)
+					func(_slots[e], _signatures[e]);
+			}
+		}
+
+		void save(snapshot &snap) const
+		{
+			snap.write(_slots.data(), _slots.size());
+			snap.write(_signatures.data(), _signatures.size());
+			snap.write(_free);
+			snap.write(_entity_count);
 		}
 
-		[[nodiscard]] signature get_signature(entity id)
+		void restore(snapshot_reader &reader)
 		{
-			assert(id < max_entities && "Entity out of range.");
-			return _signatures[id];
+			reader.read(_slots.data(), _slots.size());
+			reader.read(_signatures.data(), _signatures.size());
+			_free = reader.read<entity>();
+			_entity_count = reader.read<std::uint32_t>();
 		}
 
 	private:
-		std::queue<entity> _available_entities{};
+		std::array<entity, max_entities> _slots{};
 		std::array<signature, max_entities> _signatures{};
+		entity _free{ 1 };
 		std::uint32_t _entity_count{ 0 };
 	};
 }
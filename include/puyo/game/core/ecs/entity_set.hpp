@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "entity.hpp"
+#include "snapshot.hpp"
+
+namespace puyo
+{
+	// Sparse set of entities: `_sparse` maps an entity's index to its slot in the packed `_dense`
+	// array. A slot is only trusted if the dense entry holds the exact handle, so stale sparse
+	// entries never need clearing and handles from an older generation are never found.
+	// Erasing moves the last entity into the freed slot. Both arrays grow on demand, `_sparse`
+	// to the highest index inserted and `_dense` to the most entities held at once, and never
+	// shrink, so a set stops allocating once warmed up.
+	class entity_set final
+	{
+	public:
+		using index_type = std::uint16_t;
+		using const_iterator = const entity *;
+
+		static_assert(max_entities <= UINT16_MAX, "Sparse index type too small for max_entities.");
+
+		index_type insert(entity id)
+		{
+			assert(entity_index(id) < max_entities && "Entity out of range.");
+			assert(!contains(id) && "Entity inserted in set more than once.");
+
+			if (entity_index(id) >= _sparse.size())
+				_sparse.resize(entity_index(id) + 1u);
+
+			const auto index = static_cast<index_type>(_dense.size());
+			_sparse[entity_index(id)] = index;
+			_dense.push_back(id);
+
+			return index;
+		}
+
+		index_type erase(entity id)
+		{
+			assert(contains(id) && "Erasing entity not in set.");
+
+			const index_type removed = _sparse[entity_index(id)];
+			const entity last = _dense.back();
+
+			_dense[removed] = last;
+			_sparse[entity_index(last)] = removed;
+			_dense.pop_back();
+
+			return removed;
+		}
+
+		// Stale sparse entries are never trusted, so only the dense array needs emptying.
+		void clear() noexcept
+		{
+			_dense.clear();
+		}
+
+		// Exchanges the entities in two dense slots.
+		void swap(index_type a, index_type b) noexcept
+		{
+			assert(a < _dense.size() && b < _dense.size() && "Swapping slot out of range.");
+
+			std::swap(_dense[a], _dense[b]);
+			_sparse[entity_index(_dense[a])] = a;
+			_sparse[entity_index(_dense[b])] = b;
+		}
+
+		[[nodiscard]] bool contains(entity id) const noexcept
+		{
+			if (entity_index(id) >= _sparse.size())
+				return false;
+
+			const index_type index = _sparse[entity_index(id)];
+			return index < _dense.size() && _dense[index] == id;
+		}
+
+		[[nodiscard]] index_type index_of(entity id) const noexcept
+		{
+			assert(contains(id) && "Entity not in set.");
+			return _sparse[entity_index(id)];
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return _dense.size();
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return _dense.empty();
+		}
+
+		[[nodiscard]] entity back() const noexcept
+		{
+			assert(!empty() && "Accessing back of empty set.");
+			return _dense.back();
+		}
+
+		[[nodiscard]] const entity *data() const noexcept
+		{
+			return _dense.data();
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return _dense.data();
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return _dense.data() + _dense.size();
+		}
+
+		// Heap bytes held, including capacity not in use.
+		[[nodiscard]] std::size_t memory() const noexcept
+		{
+			return _dense.capacity() * sizeof(entity) + _sparse.capacity() * sizeof(index_type);
+		}
+
+		void save(snapshot &snap) const
+		{
+			snap.write(_dense.size());
+			snap.write(_dense.data(), _dense.size());
+			snap.write(_sparse.size());
+			snap.write(_sparse.data(), _sparse.size());
+		}
+
+		void restore(snapshot_reader &reader)
+		{
+			_dense.resize(reader.read<std::size_t>());
+			reader.read(_dense.data(), _dense.size());
+			_sparse.resize(reader.read<std::size_t>());
+			reader.read(_sparse.data(), _sparse.size());
+		}
+
+	private:
+		std::vector<entity> _dense;
+		std::vector<index_type> _sparse;
+	};
+}
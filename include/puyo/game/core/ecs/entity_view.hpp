@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+
+#include "component_array.hpp"
+#include "entity.hpp"
+#include "entity_set.hpp"
+
+namespace puyo
+{
+	// Entities owning every component in Ts, in the dense order of the cached entity set.
+	// Structural changes to the coordinator while iterating invalidate the view, except for
+	// destroying entities from the back.
+	template <typename... Ts>
+	class entity_view final
+	{
+	public:
+		using const_iterator = entity_set::const_iterator;
+
+		entity_view(const entity_set &entities, component_array<Ts> &...arrays) noexcept
+			: _entities{ entities }
+			, _arrays{ &arrays... }
+		{
+			// empty
+		}
+
+		template <typename Func>
+		void each(Func &&func)
+		{
+			for (entity e : _entities)
+				func(e, std::get<component_array<Ts> *>(_arrays)->get_data(e)...);
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return _entities.size();
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return _entities.empty();
+		}
+
+		[[nodiscard]] entity back() const noexcept
+		{
+			return _entities.back();
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return _entities.begin();
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return _entities.end();
+		}
+
+	private:
+		const entity_set &_entities;
+		std::tuple<component_array<Ts> *...> _arrays;
+	};
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "component.hpp"
+#include "component_array.hpp"
+#include "entity.hpp"
+#include "entity_manager.hpp"
+#include "signature.hpp"
+#include "snapshot.hpp"
+
+namespace puyo
+{
+	constexpr const std::size_t max_groups = 4u;
+
+	// Owning groups. Each array a group owns keeps the entities holding every component of the
+	// group packed in its first `size` slots, in the same order across arrays, so a group walks
+	// its arrays in lockstep by slot instead of looking each entity up. An array belongs to at
+	// most one group.
+	class group_manager final
+	{
+	public:
+		const std::size_t &register_group(signature sig, component_array_base *const *arrays, std::size_t count, const entity_manager &entities)
+		{
+			assert(_group_count < max_groups && "Too many groups.");
+			assert((_owned & sig).none() && "Component array owned by more than one group.");
+
+			auto &grp = _groups[_group_count++];
+			grp.sig = sig;
+			grp.count = count;
+
+			for (std::size_t i = 0; i < count; ++i)
+				grp.arrays[i] = arrays[i];
+
+			_owned |= sig;
+
+			entities.each(
+				[&](entity e, signature s)
+				{
+					if (_matches(s, sig))
+						_enter(grp, e);
+				}
+			);
+
+			return grp.size;
+		}
+
+		[[nodiscard]] const std::size_t *find(signature sig) const noexcept
+		{
+			for (std::size_t i = 0; i < _group_count; ++i)
+			{
+				if (_groups[i].sig == sig)
+					return &_groups[i].size;
+			}
+
+			return nullptr;
+		}
+
+		// Called after components are added, so entering entities have their data in place,
+		// and before they are removed, so leaving ones still do.
+		void entity_signature_changed(entity id, signature before, signature after)
+		{
+			if (((before ^ after) & _owned).none())
+				return;
+
+			for (std::size_t i = 0; i < _group_count; ++i)
+			{
+				auto &grp = _groups[i];
+				const bool was = _matches(before, grp.sig);
+				const bool is = _matches(after, grp.sig);
+
+				if (!was && is)
+					_enter(grp, id);
+				else if (was && !is)
+					_leave(grp, id);
+			}
+		}
+
+		void clear() noexcept
+		{
+			for (std::size_t i = 0; i < _group_count; ++i)
+				_groups[i].size = 0u;
+		}
+
+		void save(snapshot &snap) const
+		{
+			snap.write(_group_count);
+
+			for (std::size_t i = 0; i < _group_count; ++i)
+			{
+				snap.write(_groups[i].sig);
+				snap.write(_groups[i].size);
+			}
+		}
+
+		// Component arrays and `entities` must already be restored, which leaves every group in
+		// the snapshot packed. Groups missing here are registered as they are, with
+		// arrays_for(sig, out) writing the arrays of a signature to `out` and returning their
+		// count; groups the snapshot does not know are packed again.
+		template <typename ArraysFor>
+		void restore(snapshot_reader &reader, const entity_manager &entities, ArraysFor &&arrays_for)
+		{
+			const auto count = reader.read<std::size_t>();
+			std::array<bool, max_groups> restored{};
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const auto sig = reader.read<signature>();
+				std::size_t index = 0;
+
+				while (index < _group_count && _groups[index].sig != sig)
+					++index;
+
+				if (index == _group_count)
+				{
+					assert(_group_count < max_groups && "Too many groups.");
+					assert((_owned & sig).none() && "Component array owned by more than one group.");
+
+					auto &grp = _groups[_group_count++];
+					grp.sig = sig;
+					grp.count = arrays_for(sig, grp.arrays.data());
+					_owned |= sig;
+				}
+
+				_groups[index].size = reader.read<std::size_t>();
+				restored[index] = true;
+			}
+
+			for (std::size_t i = 0; i < _group_count; ++i)
+			{
+				if (restored[i])
+					continue;
+
+				auto &grp = _groups[i];
+				grp.size = 0u;
+
+				entities.each(
+					[&](entity e, signature s)
+					{
+						if (_matches(s, grp.sig))
+							_enter(grp, e);
+					}
+				);
+			}
+		}
+
+	private:
+		struct group final
+		{
+			signature sig;
+			std::array<component_array_base *, max_components> arrays;
+			std::size_t count;
+			std::size_t size;
+		};
+
+		std::array<group, max_groups> _groups{};
+		std::size_t _group_count{ 0 };
+		signature _owned{};
+
+		[[nodiscard]] static bool _matches(signature sig, signature required) noexcept
+		{
+			return required.any() && (sig & required) == required;
+		}
+
+		static void _enter(group &grp, entity id)
+		{
+			for (std::size_t i = 0; i < grp.count; ++i)
+				grp.arrays[i]->swap_slots(grp.arrays[i]->index_of(id), grp.size);
+
+			++grp.size;
+		}
+
+		static void _leave(group &grp, entity id)
+		{
+			--grp.size;
+
+			for (std::size_t i = 0; i < grp.count; ++i)
+				grp.arrays[i]->swap_slots(grp.arrays[i]->index_of(id), grp.size);
+		}
+	};
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include "component.hpp"
+#include "signature.hpp"
+
+namespace puyo
+{
+	// Component values and their signature, worked out once, for coordinator::instantiate to
+	// stamp out entities from.
+	template <typename... Ts>
+	class prefab final
+	{
+	public:
+		explicit prefab(Ts... components)
+			: _components{ std::move(components)... }
+		{
+			(_signature.set(component_type_of<Ts>()), ...);
+		}
+
+		[[nodiscard]] const std::tuple<Ts...> &components() const noexcept
+		{
+			return _components;
+		}
+
+		[[nodiscard]] signature get_signature() const noexcept
+		{
+			return _signature;
+		}
+
+	private:
+		std::tuple<Ts...> _components;
+		signature _signature{};
+	};
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "../../../common/thread_pool.hpp"
+
+#include "access.hpp"
+#include "command_buffer.hpp"
+#include "coordinator.hpp"
+#include "signature.hpp"
+
+namespace puyo
+{
+	// Runs systems in waves. A system goes in the wave after the last earlier system it
+	// conflicts with, two systems conflicting when either writes a component the other reads
+	// or writes, so every wave can run concurrently and declaration order is kept wherever
+	// it matters. Systems make structural changes through the command buffer they are given;
+	// each wave's buffers are flushed in declaration order once the whole wave has returned.
+	//
+	// Systems in a wave share the coordinator, so any view or group they use must already
+	// exist before a concurrent run.
+	class scheduler final
+	{
+	public:
+		using system_type = std::function<void(coordinator &, command_buffer &)>;
+
+		template <typename Access, typename Func>
+		void add(Func &&func)
+		{
+			_add(Access::read_signature(), Access::write_signature(), system_type{ std::forward<Func>(func) });
+		}
+
+		// Without a pool, or for waves of one system, systems run on the calling thread.
+		void run(coordinator &coord, thread_pool *pool = nullptr)
+		{
+			for (std::size_t w = 0; w + 1 < _waves.size(); ++w)
+			{
+				const std::size_t *const first = _order.data() + _waves[w];
+				const std::size_t count = _waves[w + 1] - _waves[w];
+
+				if (pool != nullptr && count > 1u)
+					pool->parallel_for(count, [&](std::size_t i) { _run(coord, first[i]); });
+				else
+				{
+					for (std::size_t i = 0; i < count; ++i)
+						_run(coord, first[i]);
+				}
+
+				for (std::size_t i = 0; i < count; ++i)
+					_systems[first[i]].commands.flush(coord);
+			}
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return _systems.size();
+		}
+
+		[[nodiscard]] std::size_t waves() const noexcept
+		{
+			return _waves.empty() ? 0u : _waves.size() - 1u;
+		}
+
+	private:
+		struct system final
+		{
+			signature reads;
+			signature writes;
+			std::size_t wave;
+			system_type func;
+			command_buffer commands;
+		};
+
+		std::vector<system> _systems;
+
+		// System indices by wave, declaration order within each; wave w is
+		// _order[_waves[w], _waves[w + 1]).
+		std::vector<std::size_t> _order;
+		std::vector<std::size_t> _waves;
+
+		[[nodiscard]] static bool _conflicts(const system &a, signature reads, signature writes) noexcept
+		{
+			return (a.writes & (reads | writes)).any() || (writes & a.reads).any();
+		}
+
+		void _add(signature reads, signature writes, system_type func)
+		{
+			std::size_t wave = 0;
+
+			for (const auto &other : _systems)
+			{
+				if (_conflicts(other, reads, writes))
+					wave = std::max(wave, other.wave + 1u);
+			}
+
+			_systems.push_back({ reads, writes, wave, std::move(func), command_buffer{} });
+
+			_order.resize(_systems.size());
+
+			for (std::size_t i = 0; i < _order.size(); ++i)
+				_order[i] = i;
+
+			std::stable_sort(_order.begin(), _order.end(), [&](std::size_t a, std::size_t b) { return _systems[a].wave < _systems[b].wave; });
+
+			_waves.assign(1u, 0u);
+
+			for (std::size_t i = 0; i < _order.size(); ++i)
+			{
+				if (i + 1u == _order.size() || _systems[_order[i + 1u]].wave != _systems[_order[i]].wave)
+					_waves.push_back(i + 1u);
+			}
+		}
+
+		void _run(coordinator &coord, std::size_t i)
+		{
+			auto &sys = _systems[i];
+			sys.func(coord, sys.commands);
+		}
+	};
+}
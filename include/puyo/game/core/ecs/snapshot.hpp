@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace puyo
+{
+	// Flat byte image of a world, written and read back in the same order. Only trivially
+	// copyable data goes in, so saving and restoring are runs of memcpy. The buffer keeps its
+	// capacity, so saving the same world into the same snapshot again does not allocate.
+	class snapshot final
+	{
+	public:
+		template <typename T>
+		void write(const T *data, std::size_t count)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable data can be snapshotted.");
+
+			const std::size_t at = _bytes.size();
+			_bytes.resize(at + count * sizeof(T));
+
+			if (count != 0u)
+				std::memcpy(_bytes.data() + at, data, count * sizeof(T));
+		}
+
+		template <typename T>
+		void write(const T &value)
+		{
+			write(&value, 1u);
+		}
+
+		void clear() noexcept
+		{
+			_bytes.clear();
+		}
+
+		[[nodiscard]] const unsigned char *data() const noexcept
+		{
+			return _bytes.data();
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return _bytes.size();
+		}
+
+	private:
+		std::vector<unsigned char> _bytes;
+	};
+
+	class snapshot_reader final
+	{
+	public:
+		explicit snapshot_reader(const snapshot &snap) noexcept
+			: _data{ snap.data() }
+			, _size{ snap.size() }
+		{
+			// empty
+		}
+
+		template <typename T>
+		void read(T *data, std::size_t count) noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable data can be snapshotted.");
+			assert(_at + count * sizeof(T) <= _size && "Reading past the end of a snapshot.");
+
+			if (count != 0u)
+				std::memcpy(data, _data + _at, count * sizeof(T));
+
+			_at += count * sizeof(T);
+		}
+
+		template <typename T>
+		[[nodiscard]] T read() noexcept
+		{
+			T value;
+			read(&value, 1u);
+			return value;
+		}
+
+		[[nodiscard]] bool done() const noexcept
+		{
+			return _at == _size;
+		}
+
+	private:
+		const unsigned char *_data;
+		std::size_t _size;
+		std::size_t _at{ 0 };
+	};
+}
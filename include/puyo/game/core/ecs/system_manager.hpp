@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "entity.hpp"
+#include "entity_manager.hpp"
+#include "entity_set.hpp"
+#include "signature.hpp"
+#include "snapshot.hpp"
+
+namespace puyo
+{
+	constexpr const std::size_t max_systems = 16u;
+
+	// Keeps one entity set per registered signature, updated as signatures change, so
+	// systems iterate exactly the entities they need in dense order.
+	class system_manager final
+	{
+	public:
+		const entity_set &register_signature(signature sig, const entity_manager &entities)
+		{
+			assert(_system_count < max_systems && "Too many system signatures.");
+
+			auto &sys = _systems[_system_count++];
+			sys.sig = sig;
+
+			entities.each(
+				[&](entity e, signature s)
+				{
+					if (_matches(s, sig))
+						sys.entities.insert(e);
+				}
+			);
+
+			return sys.entities;
+		}
+
+		[[nodiscard]] const entity_set *find(signature sig) const noexcept
+		{
+			for (std::size_t i = 0; i < _system_count; ++i)
+			{
+				if (_systems[i].sig == sig)
+					return &_systems[i].entities;
+			}
+
+			return nullptr;
+		}
+
+		void entity_signature_changed(entity id, signature sig)
+		{
+			for (std::size_t i = 0; i < _system_count; ++i)
+			{
+				auto &sys = _systems[i];
+				const bool matches = _matches(sig, sys.sig);
+				const bool contained = sys.entities.contains(id);
+
+				if (matches && !contained)
+					sys.entities.insert(id);
+				else if (!matches && contained)
+					sys.entities.erase(id);
+			}
+		}
+
+		// Only sets whose signature `sig` matched can hold the entity.
+		void entity_destroyed(entity id, signature sig)
+		{
+			for (std::size_t i = 0; i < _system_count; ++i)
+			{
+				auto &sys = _systems[i];
+
+				if (_matches(sig, sys.sig))
+					sys.entities.erase(id);
+			}
+		}
+
+		[[nodiscard]] std::size_t memory() const noexcept
+		{
+			std::size_t bytes = sizeof(*this);
+
+			for (std::size_t i = 0; i < _system_count; ++i)
+				bytes += _systems[i].entities.memory();
+
+			return bytes;
+		}
+
+		void clear() noexcept
+		{
+			for (std::size_t i = 0; i < _system_count; ++i)
+				_systems[i].entities.clear();
+		}
+
+		void save(snapshot &snap) const
+		{
+			snap.write(_system_count);
+
+			for (std::size_t i = 0; i < _system_count; ++i)
+			{
+				snap.write(_systems[i].sig);
+				_systems[i].entities.save(snap);
+			}
+		}
+
+		// `entities` must already be restored. Signatures missing here are registered, and sets
+		// the snapshot does not know are rebuilt from `entities`.
+		void restore(snapshot_reader &reader, const entity_manager &entities)
+		{
+			const auto count = reader.read<std::size_t>();
+			std::array<bool, max_systems> restored{};
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const auto sig = reader.read<signature>();
+				const std::size_t index = _index_of(sig);
+
+				_systems[index].entities.restore(reader);
+				restored[index] = true;
+			}
+
+			for (std::size_t i = 0; i < _system_count; ++i)
+			{
+				if (restored[i])
+					continue;
+
+				auto &sys = _systems[i];
+				sys.entities.clear();
+
+				entities.each(
+					[&](entity e, signature s)
+					{
+						if (_matches(s, sys.sig))
+							sys.entities.insert(e);
+					}
+				);
+			}
+		}
+
+	private:
+		struct system final
+		{
+			signature sig;
+			entity_set entities;
+		};
+
+		std::array<system, max_systems> _systems{};
+		std::size_t _system_count{ 0 };
+
+		// Index of the set for `sig`, registering an empty one if there is none.
+		std::size_t _index_of(signature sig)
+		{
+			for (std::size_t i = 0; i < _system_count; ++i)
+			{
+				if (_systems[i].sig == sig)
+					return i;
+			}
+
+			assert(_system_count < max_systems && "Too many system signatures.");
+
+			_systems[_system_count].sig = sig;
+			return _system_count++;
+		}
+
+		[[nodiscard]] static bool _matches(signature sig, signature required) noexcept
+		{
+			return required.any() && (sig & required) == required;
+		}
+	};
+}
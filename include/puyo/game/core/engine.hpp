@@ -1,6 +1,9 @@
 #pragma once
 
 #include <filesystem>
+#include <random>
+
+#include "../../common/log.hpp"
 
 #include "../../wrapper/graphics/window.hpp"
 #include "../../wrapper/events/event.hpp"
@@ -41,6 +44,8 @@ namespace puyo
 			_window.show();
 			_loop.fetch_current_time();
 
+			// Only interactive play is seeded at random; headless runs pick their seeds.
+			_game.seed(std::random_device{}());
 			_game.on_start();
 
 			while (_loop.is_running())
@@ -65,6 +70,7 @@ namespace puyo
 		game_type _game{};
 		loop_type _loop;
 		input _input;
+		int _score{ 0 };
 
 		bool update_input()
 		{
@@ -72,7 +78,7 @@ namespace puyo
 
 			sdl::event::update();
 
-			_game.handle_input(_input);
+			_game.handle_input(to_actions(_input));
 
 			return !sdl::event::in_queue(sdl::event_type::quit);
 		}
@@ -80,6 +86,13 @@ namespace puyo
 		void update_logic(float dt)
 		{
 			_game.tick(dt);
+
+			const int current = _game.current_score();
+
+			if (current > _score)
+				log::logline(log::info, "%d", current);
+
+			_score = current;
 		}
 	};
 }
@@ -1,17 +1,31 @@
 #pragma once
 
+#include <cstdint>
+
+#include "ecs/command_buffer.hpp"
 #include "ecs/coordinator.hpp"
 #include "ecs/entity.hpp"
+#include "ecs/snapshot.hpp"
 
-#include "input.hpp"
-#include "graphics.hpp"
+#include "actions.hpp"
+#include "piece_generator.hpp"
 
 namespace puyo
 {
+	class graphics;
+
+	// How blobs come to rest: a cell at a time over many ticks, as drawn, or straight where
+	// they end up, in one tick, for headless play and search. Both leave the same board.
+	enum class resolve_mode
+	{
+		animated,
+		instant
+	};
+
 	class game final
 	{
 	public:
-		void handle_input(const input &input);
+		void handle_input(const actions &input);
 
 		void tick(float dt);
 
@@ -21,10 +35,32 @@ namespace puyo
 
 		void on_exit();
 
+		// Restarts the pair sequence; games seeded alike and fed the same actions play alike.
+		void seed(std::uint64_t seed);
+
+		// In instant mode a pressed drop places the pair at once and falls settle in one tick.
+		void set_resolve_mode(resolve_mode mode);
+
+		[[nodiscard]] int current_score() const;
+
+		// Zobrist hash of the blobs on the board, pair included; equal boards hash alike.
+		[[nodiscard]] std::uint64_t board_hash() const;
+
+		[[nodiscard]] memory_usage memory() const;
+
+		// The world, entity handles and game state, for search and rollback. A snapshot only
+		// restores into a game that has been started.
+		void save(snapshot &snap) const;
+		void restore(const snapshot &snap);
+
 	private:
 		bool _paused{ false };
+		resolve_mode _resolve{ resolve_mode::animated };
 
 		coordinator _coord{};
+		command_buffer _commands{};
+		piece_generator _pieces{};
+		std::uint32_t _rendered{ 0 };
 
 		enum class _game_state
 		{
@@ -34,11 +70,11 @@ namespace puyo
 		};
 		_game_state _state{ _game_state::pair };
 
-		entity _grid;
-		entity _falling;
-		entity _chains;
-		entity _pair;
-		entity _score;
+		entity _grid{ 0 };
+		entity _falling{ 0 };
+		entity _chains{ 0 };
+		entity _pair{ 0 };
+		entity _score{ 0 };
 
 		void _init_game();
 		void _reset_game();
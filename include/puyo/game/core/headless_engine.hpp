@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+#include "actions.hpp"
+#include "game.hpp"
+
+namespace puyo
+{
+	// Drives a game without a window, renderer or keyboard: every step feeds one set of
+	// actions and advances the rules by a fixed delta, as fast as the caller asks.
+	template <typename Game = game>
+	class headless_engine
+	{
+	public:
+		using game_type = Game;
+		using precision_type = float;
+
+		constexpr inline static precision_type default_delta = 1.f / 60.f;
+
+		explicit headless_engine(precision_type delta = default_delta) : _delta{ delta }
+		{
+			_game.on_start();
+		}
+
+		~headless_engine()
+		{
+			_game.on_exit();
+		}
+
+		headless_engine(const headless_engine &) = delete;
+		headless_engine &operator=(const headless_engine &) = delete;
+
+		headless_engine(headless_engine &&) = delete;
+		headless_engine &operator=(headless_engine &&) = delete;
+
+		void step(const actions &input = {})
+		{
+			_game.handle_input(input);
+			_game.tick(_delta);
+			++_ticks;
+		}
+
+		void run(std::uint64_t ticks)
+		{
+			for (std::uint64_t i = 0; i < ticks; ++i)
+				step();
+		}
+
+		// Policy is invoked once per tick as `actions(game_type &)`.
+		template <typename Policy>
+		void run(std::uint64_t ticks, Policy &&policy)
+		{
+			for (std::uint64_t i = 0; i < ticks; ++i)
+				step(policy(_game));
+		}
+
+		[[nodiscard]] game_type &game() noexcept
+		{
+			return _game;
+		}
+
+		[[nodiscard]] std::uint64_t ticks() const noexcept
+		{
+			return _ticks;
+		}
+
+		[[nodiscard]] precision_type delta() const noexcept
+		{
+			return _delta;
+		}
+
+	private:
+		game_type _game{};
+		precision_type _delta;
+		std::uint64_t _ticks{ 0 };
+	};
+}
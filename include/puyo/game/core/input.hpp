@@ -2,10 +2,36 @@
 
 #include "../../wrapper/input/keyboard.hpp"
 
+#include "../ctx/binds.hpp"
+
+#include "actions.hpp"
+
 namespace puyo
 {
 	struct input final
 	{
 		sdl::keyboard keyboard;
 	};
+
+	[[nodiscard]] inline actions to_actions(const input &input)
+	{
+		const auto &keyboard = input.keyboard;
+
+		actions act{};
+
+		act.left = keyboard.just_pressed(ctx::binds::left);
+		act.right = keyboard.just_pressed(ctx::binds::right);
+		act.rotate_left = keyboard.just_pressed(ctx::binds::rotl);
+		act.rotate_right = keyboard.just_pressed(ctx::binds::rotr);
+
+		if (keyboard.is_held(ctx::binds::down))
+			act.drop = drop_t::pressed;
+		else if (keyboard.just_released(ctx::binds::down))
+			act.drop = drop_t::released;
+
+		act.pause = keyboard.just_pressed(ctx::binds::pause);
+		act.restart = keyboard.just_pressed(ctx::binds::restart);
+
+		return act;
+	}
 }
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#if !defined(PUYO_NO_SIMD) && defined(__AVX2__)
+#define PUYO_LABEL_AVX2
+#include <immintrin.h>
+#elif !defined(PUYO_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PUYO_LABEL_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "../components/gameplay/color.hpp"
+
+#include "bitboard.hpp"
+#include "constants.hpp"
+
+namespace puyo
+{
+	struct color_group final
+	{
+		bitboard cells;
+		color_t color;
+		int size;
+	};
+
+	// Enough room for every cell being its own group.
+	using color_groups = std::array<color_group, grid_size>;
+
+	namespace detail
+	{
+		// The four colour boards are flooded in lockstep, one seed per colour per round. Each
+		// lane policy provides load/store of all four boards, one dilate-and-mask step and an
+		// all-lanes-equal test.
+	#if defined(PUYO_LABEL_AVX2)
+		struct label_lanes final
+		{
+			// Two boards per register; byte shifts stay within their 128-bit lane, which is
+			// exactly one board, and the 64-bit shifts only leak across the row boundary that
+			// the column masks discard anyway.
+			__m256i v[2];
+
+			static label_lanes load(const bitboard *b) noexcept
+			{
+				return { { _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b)), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + 2)) } };
+			}
+
+			void store(bitboard *b) const noexcept
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(b), v[0]);
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(b + 2), v[1]);
+			}
+
+			static __m256i step(__m256i s, __m256i m) noexcept
+			{
+				const __m256i not_col_0 = _mm256_set1_epi64x(static_cast<long long>(~bitboards::column_0));
+				const __m256i not_col_7 = _mm256_set1_epi64x(static_cast<long long>(~bitboards::column_7));
+
+				__m256i r = _mm256_or_si256(s, _mm256_srli_si256(s, 1));
+				r = _mm256_or_si256(r, _mm256_slli_si256(s, 1));
+				r = _mm256_or_si256(r, _mm256_and_si256(_mm256_srli_epi64(s, 1), not_col_7));
+				r = _mm256_or_si256(r, _mm256_and_si256(_mm256_slli_epi64(s, 1), not_col_0));
+
+				return _mm256_and_si256(r, m);
+			}
+
+			static label_lanes step(const label_lanes &s, const label_lanes &m) noexcept
+			{
+				return { { step(s.v[0], m.v[0]), step(s.v[1], m.v[1]) } };
+			}
+
+			static bool equal(const label_lanes &a, const label_lanes &b) noexcept
+			{
+				const __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(a.v[0], b.v[0]), _mm256_cmpeq_epi8(a.v[1], b.v[1]));
+				return _mm256_movemask_epi8(eq) == -1;
+			}
+		};
+	#elif defined(PUYO_LABEL_SSE2)
+		struct label_lanes final
+		{
+			// One board per register, lo in the low quadword.
+			__m128i v[4];
+
+			static label_lanes load(const bitboard *b) noexcept
+			{
+				label_lanes l;
+
+				for (std::size_t i = 0; i < 4; ++i)
+					l.v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+
+				return l;
+			}
+
+			void store(bitboard *b) const noexcept
+			{
+				for (std::size_t i = 0; i < 4; ++i)
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(b + i), v[i]);
+			}
+
+			static __m128i step(__m128i s, __m128i m) noexcept
+			{
+				const __m128i not_col_0 = _mm_set1_epi64x(static_cast<long long>(~bitboards::column_0));
+				const __m128i not_col_7 = _mm_set1_epi64x(static_cast<long long>(~bitboards::column_7));
+
+				__m128i r = _mm_or_si128(s, _mm_srli_si128(s, 1));
+				r = _mm_or_si128(r, _mm_slli_si128(s, 1));
+				r = _mm_or_si128(r, _mm_and_si128(_mm_srli_epi64(s, 1), not_col_7));
+				r = _mm_or_si128(r, _mm_and_si128(_mm_slli_epi64(s, 1), not_col_0));
+
+				return _mm_and_si128(r, m);
+			}
+
+			static label_lanes step(const label_lanes &s, const label_lanes &m) noexcept
+			{
+				label_lanes l;
+
+				for (std::size_t i = 0; i < 4; ++i)
+					l.v[i] = step(s.v[i], m.v[i]);
+
+				return l;
+			}
+
+			static bool equal(const label_lanes &a, const label_lanes &b) noexcept
+			{
+				__m128i eq = _mm_cmpeq_epi8(a.v[0], b.v[0]);
+
+				for (std::size_t i = 1; i < 4; ++i)
+					eq = _mm_and_si128(eq, _mm_cmpeq_epi8(a.v[i], b.v[i]));
+
+				return _mm_movemask_epi8(eq) == 0xFFFF;
+			}
+		};
+	#else
+		struct label_lanes final
+		{
+			bitboard v[4];
+
+			static label_lanes load(const bitboard *b) noexcept
+			{
+				return { { b[0], b[1], b[2], b[3] } };
+			}
+
+			void store(bitboard *b) const noexcept
+			{
+				for (std::size_t i = 0; i < 4; ++i)
+					b[i] = v[i];
+			}
+
+			static label_lanes step(const label_lanes &s, const label_lanes &m) noexcept
+			{
+				label_lanes l;
+
+				for (std::size_t i = 0; i < 4; ++i)
+					l.v[i] = bitboards::dilate(s.v[i]) & m.v[i];
+
+				return l;
+			}
+
+			static bool equal(const label_lanes &a, const label_lanes &b) noexcept
+			{
+				bool eq = true;
+
+				for (std::size_t i = 0; i < 4; ++i)
+					eq &= a.v[i] == b.v[i];
+
+				return eq;
+			}
+		};
+	#endif
+	}
+
+	// Labels the connected same-colour groups containing at least one cell of `touching` and
+	// writes those with at least `min_size` cells to `out`, returning how many were written.
+	// Groups are flooded one per colour per round and come out ordered by their lowest cell, so
+	// the order does not depend on which of their cells were asked for.
+	inline std::size_t label_groups(const std::array<bitboard, color_count> &boards, const bitboard &touching, int min_size, color_group *out) noexcept
+	{
+		static_assert(color_count == 4, "label_groups floods exactly four colour boards in lockstep.");
+
+		const auto mask = detail::label_lanes::load(boards.data());
+
+		std::array<bitboard, color_count> remaining;
+		std::array<bitboard, color_count> seeds{};
+		std::size_t count = 0;
+
+		for (std::size_t i = 0; i < color_count; ++i)
+			remaining[i] = boards[i] & touching;
+
+		while ((remaining[0] | remaining[1] | remaining[2] | remaining[3]).any())
+		{
+			for (std::size_t i = 0; i < color_count; ++i)
+				seeds[i] = remaining[i].lowest();
+
+			auto flood = detail::label_lanes::load(seeds.data());
+
+			for (auto next = detail::label_lanes::step(flood, mask); !detail::label_lanes::equal(next, flood); next = detail::label_lanes::step(flood, mask))
+				flood = next;
+
+			flood.store(seeds.data());
+
+			for (std::size_t i = 0; i < color_count; ++i)
+			{
+				const bitboard &group = seeds[i];
+
+				if (!group.any())
+					continue;
+
+				remaining[i] &= ~group;
+
+				const int size = group.count();
+
+				if (size >= min_size)
+					out[count++] = { group, static_cast<color_t>(i + 1), size };
+			}
+		}
+
+		for (std::size_t i = 1; i < count; ++i)
+		{
+			const color_group g = out[i];
+			const std::size_t first = g.cells.first();
+			std::size_t j = i;
+
+			for (; j > 0 && out[j - 1].cells.first() > first; --j)
+				out[j] = out[j - 1];
+
+			out[j] = g;
+		}
+
+		return count;
+	}
+
+	// Every group on the board.
+	inline std::size_t label_groups(const std::array<bitboard, color_count> &boards, int min_size, color_group *out) noexcept
+	{
+		return label_groups(boards, ~bitboard{}, min_size, out);
+	}
+}
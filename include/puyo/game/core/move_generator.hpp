@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../components/gameplay/color.hpp"
+
+#include "bitboard.hpp"
+#include "constants.hpp"
+
+namespace puyo
+{
+	// Where the second blob of a pair sits relative to the first, clockwise, so rotating right
+	// is +1 and rotating left is -1, as in handle_pair_input.
+	enum class orientation : std::uint8_t
+	{
+		up,
+		right,
+		down,
+		left
+	};
+
+	inline constexpr std::size_t orientation_count{ 4 };
+
+	// A drop of the current pair: the column and orientation it is held in when released, the
+	// cells both blobs come to rest in, and the colour boards with them placed.
+	struct placement final
+	{
+		std::uint8_t column;
+		orientation turn;
+		std::uint8_t center_cell;
+		std::uint8_t other_cell;
+		std::array<bitboard, color_count> boards;
+	};
+
+	// Every orientation in every column.
+	using placements = std::array<placement, grid_width * orientation_count>;
+
+	namespace detail
+	{
+		// Cells where a pair centred there, held in orientation `o`, fits on `empty`.
+		[[nodiscard]] inline bitboard pair_fits(const bitboard &empty, orientation o) noexcept
+		{
+			switch (o)
+			{
+			case orientation::up: return empty & bitboards::shift_down(empty);
+			case orientation::right: return empty & bitboards::shift_left(empty);
+			case orientation::down: return empty & bitboards::shift_up(empty);
+			case orientation::left: return empty & bitboards::shift_right(empty);
+			}
+
+			return {};
+		}
+
+		// Top free cell of `column`; the column must have one. Boards between pairs have no
+		// overhangs, so a dropped blob comes to rest right on top of the column.
+		[[nodiscard]] inline std::size_t landing_cell(const bitboard &occupied, std::size_t column) noexcept
+		{
+			const bitboard stack = occupied & bitboard{ bitboards::column_0 << column, bitboards::column_0 << column };
+			return (stack.any() ? stack.first() : grid_size + column) - grid_width;
+		}
+	}
+
+	// Writes every placement the pair can reach from its current position to `out` and returns
+	// how many there are. `boards` must not hold the pair itself. Reachable positions are
+	// flooded over all orientations at once: the pair may shift left or right, fall a row, or
+	// rotate a quarter turn about its center, each only into cells that are free, so the set
+	// matches what handle_pair_input and try_move_pair allow over time. A pair of one colour
+	// skips the orientations that mirror another and would give the same board.
+	inline std::size_t generate_placements(const std::array<bitboard, color_count> &boards, std::size_t center_cell, orientation turn, color_t center, color_t other, placement *out) noexcept
+	{
+		const bitboard occupied = boards[0] | boards[1] | boards[2] | boards[3];
+		const bitboard empty = ~occupied;
+
+		std::array<bitboard, orientation_count> fits;
+		std::array<bitboard, orientation_count> reached{};
+
+		for (std::size_t o = 0; o < orientation_count; ++o)
+			fits[o] = detail::pair_fits(empty, static_cast<orientation>(o));
+
+		reached[static_cast<std::size_t>(turn)].set(center_cell);
+		reached[static_cast<std::size_t>(turn)] &= fits[static_cast<std::size_t>(turn)];
+
+		for (bool grew = true; grew;)
+		{
+			grew = false;
+
+			for (std::size_t o = 0; o < orientation_count; ++o)
+			{
+				const bitboard &r = reached[o];
+				const bitboard turned = reached[(o + 1u) % orientation_count] | reached[(o + orientation_count - 1u) % orientation_count];
+				const bitboard next = (r | bitboards::shift_left(r) | bitboards::shift_right(r) | bitboards::shift_down(r) | turned) & fits[o];
+
+				if (next != r)
+				{
+					reached[o] = next;
+					grew = true;
+				}
+			}
+		}
+
+		// Reached anywhere in a column means it can be dropped from there.
+		std::array<std::uint8_t, orientation_count> columns;
+
+		for (std::size_t o = 0; o < orientation_count; ++o)
+		{
+			std::uint64_t rows = reached[o].lo | reached[o].hi;
+			rows |= rows >> 32;
+			rows |= rows >> 16;
+			rows |= rows >> 8;
+			columns[o] = static_cast<std::uint8_t>(rows);
+		}
+
+		std::size_t turns = orientation_count;
+
+		if (center == other)
+		{
+			// Down in a column gives the board of up, and left in a column that of right one
+			// column over.
+			columns[static_cast<std::size_t>(orientation::up)] |= columns[static_cast<std::size_t>(orientation::down)];
+			columns[static_cast<std::size_t>(orientation::right)] |= columns[static_cast<std::size_t>(orientation::left)] >> 1;
+			turns = 2u;
+		}
+
+		std::size_t count = 0;
+
+		for (std::size_t o = 0; o < turns; ++o)
+		{
+			const auto t = static_cast<orientation>(o);
+
+			for (std::size_t x = 0; x < grid_width; ++x)
+			{
+				if (((columns[o] >> x) & 1u) == 0u)
+					continue;
+
+				placement &p = out[count++];
+				p.column = static_cast<std::uint8_t>(x);
+				p.turn = t;
+				p.boards = boards;
+
+				bitboard filled = occupied;
+
+				// The lower blob of a vertical pair lands first.
+				const std::size_t other_x = t == orientation::right ? x + 1u : t == orientation::left ? x - 1u : x;
+				const bool other_first = t == orientation::down;
+
+				const std::size_t first = detail::landing_cell(filled, other_first ? other_x : x);
+				filled.set(first);
+				const std::size_t second = detail::landing_cell(filled, other_first ? x : other_x);
+
+				p.center_cell = static_cast<std::uint8_t>(other_first ? second : first);
+				p.other_cell = static_cast<std::uint8_t>(other_first ? first : second);
+
+				p.boards[center - 1].set(p.center_cell);
+				p.boards[other - 1].set(p.other_cell);
+			}
+		}
+
+		return count;
+	}
+}
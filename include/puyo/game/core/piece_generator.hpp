@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "../components/gameplay/color.hpp"
+
+namespace puyo
+{
+	struct piece final
+	{
+		color_t center;
+		color_t other;
+	};
+
+	// Seeded source of the pair sequence. xoshiro256** output is cut into two-bit colours, a
+	// block of pairs at a time, into a ring that also serves look-ahead. The state is a few
+	// plain arrays, so it is trivially copyable and goes into snapshots as is; equal seeds
+	// give equal sequences on every platform.
+	class piece_generator final
+	{
+	public:
+		// Pairs generated per refill; also how far ahead peek() can see.
+		static constexpr std::size_t block_size{ 32 };
+
+		explicit piece_generator(std::uint64_t seed = 0u) noexcept
+		{
+			reseed(seed);
+		}
+
+		void reseed(std::uint64_t seed) noexcept
+		{
+			// splitmix64, as recommended for filling xoshiro state from one word.
+			for (auto &word : _state)
+			{
+				seed += 0x9E3779B97F4A7C15u;
+
+				std::uint64_t z = seed;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+				word = z ^ (z >> 31);
+			}
+
+			_head = 0u;
+			_count = 0u;
+		}
+
+		[[nodiscard]] piece next() noexcept
+		{
+			if (_count == 0u)
+				_refill();
+
+			const piece p = _ring[_head];
+			_head = (_head + 1u) % _ring.size();
+			--_count;
+
+			return p;
+		}
+
+		// The pair `ahead` spawns after the next one, without consuming anything.
+		[[nodiscard]] piece peek(std::size_t ahead = 0u) noexcept
+		{
+			assert(ahead < block_size && "Peeking further than one block.");
+
+			if (_count <= ahead)
+				_refill();
+
+			return _ring[(_head + ahead) % _ring.size()];
+		}
+
+	private:
+		std::array<std::uint64_t, 4> _state{};
+		std::array<piece, 2 * block_size> _ring{};
+		std::size_t _head{ 0 };
+		std::size_t _count{ 0 };
+
+		[[nodiscard]] static std::uint64_t _rotate_left(std::uint64_t x, int k) noexcept
+		{
+			return (x << k) | (x >> (64 - k));
+		}
+
+		[[nodiscard]] std::uint64_t _next_word() noexcept
+		{
+			const std::uint64_t result = _rotate_left(_state[1] * 5u, 7) * 9u;
+			const std::uint64_t t = _state[1] << 17;
+
+			_state[2] ^= _state[0];
+			_state[3] ^= _state[1];
+			_state[1] ^= _state[2];
+			_state[0] ^= _state[3];
+			_state[2] ^= t;
+			_state[3] = _rotate_left(_state[3], 45);
+
+			return result;
+		}
+
+		// One word holds 32 colours, 16 pairs.
+		void _refill() noexcept
+		{
+			static_assert(color_count == 4, "Colours are drawn two bits at a time.");
+			static_assert(block_size % 16 == 0, "Blocks are whole words of pairs.");
+
+			assert(_count + block_size <= _ring.size() && "Piece ring overflow.");
+
+			std::size_t tail = (_head + _count) % _ring.size();
+
+			for (std::size_t w = 0; w < block_size / 16; ++w)
+			{
+				std::uint64_t bits = _next_word();
+
+				for (std::size_t i = 0; i < 16; ++i, bits >>= 4)
+				{
+					_ring[tail] = { static_cast<color_t>((bits & 3u) + 1u), static_cast<color_t>(((bits >> 2) & 3u) + 1u) };
+					tail = (tail + 1u) % _ring.size();
+				}
+			}
+
+			_count += block_size;
+		}
+	};
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../components/gameplay/color.hpp"
+
+#include "bitboard.hpp"
+#include "constants.hpp"
+
+namespace puyo
+{
+	namespace zobrist
+	{
+		using keys_t = std::array<std::array<std::uint64_t, grid_size>, color_count>;
+
+		// One key per colour per cell, from splitmix64 over a fixed seed, so hashes are the same
+		// in every build and on every platform.
+		[[nodiscard]] constexpr keys_t make_keys() noexcept
+		{
+			keys_t keys{};
+			std::uint64_t seed = 0x5A0B'1E57'0B0A'12D5u;
+
+			for (auto &color_keys : keys)
+			{
+				for (auto &key : color_keys)
+				{
+					seed += 0x9E3779B97F4A7C15u;
+
+					std::uint64_t z = seed;
+					z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+					z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+					key = z ^ (z >> 31);
+				}
+			}
+
+			return keys;
+		}
+
+		inline constexpr keys_t keys{ make_keys() };
+
+		[[nodiscard]] inline std::uint64_t key(std::size_t cell, color_t c) noexcept
+		{
+			return keys[c - 1][cell];
+		}
+	}
+
+	// Hash of a board worked out from scratch; what an incrementally kept hash must equal. The
+	// empty board hashes to 0.
+	[[nodiscard]] inline std::uint64_t zobrist_hash(const std::array<bitboard, color_count> &boards) noexcept
+	{
+		std::uint64_t hash = 0u;
+
+		for (std::size_t i = 0; i < color_count; ++i)
+		{
+			boards[i].for_each(
+				[&](std::size_t cell)
+				{
+					hash ^= zobrist::keys[i][cell];
+				}
+			);
+		}
+
+		return hash;
+	}
+}
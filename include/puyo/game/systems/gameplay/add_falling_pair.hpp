@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../core/ecs/access.hpp"
 #include "../../core/ecs/entity.hpp"
 #include "../../core/ecs/coordinator.hpp"
 
@@ -10,13 +11,15 @@ namespace puyo
 {
 	namespace sys
 	{
-		void add_falling_pair(coordinator &coord, entity &fall, entity &e)
+		using add_falling_pair_access = access<reads<pair>, writes<falling>>;
+
+		inline void add_falling_pair(coordinator &coord, entity &fall, entity &e)
 		{
 			auto &f = coord.get_component<falling>(fall);
 			auto &p = coord.get_component<pair>(e);
 
-			f.pieces.push_back(p.center);
-			f.pieces.push_back(p.other);
+			f.push_back(p.center);
+			f.push_back(p.other);
 		}
 	}
 }
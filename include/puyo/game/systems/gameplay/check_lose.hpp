@@ -1,9 +1,11 @@
 #pragma once
 
 #include "../../core/constants.hpp"
+#include "../../core/ecs/access.hpp"
 #include "../../core/ecs/coordinator.hpp"
 #include "../../core/ecs/entity.hpp"
 
+#include "../../components/gameplay/color.hpp"
 #include "../../components/gameplay/grid.hpp"
 #include "../../components/gameplay/pair.hpp"
 #include "../../components/movement/transform.hpp"
@@ -12,7 +14,9 @@ namespace puyo
 {
 	namespace sys
 	{
-		bool check_lose(coordinator &coord, entity &gr, entity &e)
+		using check_lose_access = access<reads<pair, transform, color>, writes<grid>>;
+
+		inline bool check_lose(coordinator &coord, entity &gr, entity &e)
 		{
 			auto &g = coord.get_component<grid>(gr);
 			auto &p = coord.get_component<pair>(e);
@@ -29,8 +33,8 @@ namespace puyo
 			if (g.board_blobs[xc + yc * grid_width] != 0u || g.board_blobs[xo + yo * grid_width] != 0u)
 				return true;
 
-			g.board_blobs[xc + yc * grid_width] = p.center;
-			g.board_blobs[xo + yo * grid_width] = p.other;
+			place_blob(g, xc + yc * grid_width, p.center, coord.get_component<color>(p.center).blob_color);
+			place_blob(g, xo + yo * grid_width, p.other, coord.get_component<color>(p.other).blob_color);
 
 			return false;
 		}
@@ -1,19 +1,20 @@
 #pragma once
 
-#include <algorithm>
-#include <iterator>
+#include <cstddef>
 
+#include "../../core/bitboard.hpp"
 #include "../../core/constants.hpp"
+#include "../../core/ecs/access.hpp"
+#include "../../core/ecs/command_buffer.hpp"
 #include "../../core/ecs/coordinator.hpp"
 #include "../../core/ecs/entity.hpp"
 
-#include "../../components/gameplay/belonging_chain.hpp"
 #include "../../components/gameplay/chains.hpp"
+#include "../../components/gameplay/color.hpp"
 #include "../../components/gameplay/falling.hpp"
 #include "../../components/gameplay/grid.hpp"
 #include "../../components/gameplay/score.hpp"
 #include "../../components/gameplay/state.hpp"
-#include "../../components/movement/transform.hpp"
 
 namespace puyo
 {
@@ -21,69 +22,62 @@ namespace puyo
 	{
 		namespace
 		{
-			void delete_blob(coordinator &coord, entity &gr, entity &e)
-			{
-				auto &g = coord.get_component<grid>(gr);
-				auto &t = coord.get_component<transform>(e);
-				g.board_blobs[t.grid_position.x() + t.grid_position.y() * grid_width] = 0u;
-				coord.destroy_entity(e);
-			}
 
-			void set_falling(coordinator &coord, entity &gr, entity &fall, entity &ch, entity &e)
+			void set_falling(coordinator &coord, grid &g, falling &f, const bitboard &cleared, std::size_t cell)
 			{
-				auto &g = coord.get_component<grid>(gr);
-				auto &c = coord.get_component<chains>(ch);
-				auto &f = coord.get_component<falling>(fall);
-
-				auto &t = coord.get_component<transform>(e);
 				int
-					x = t.grid_position.x(),
-					y = t.grid_position.y() - 1;
+					x = static_cast<int>(cell % grid_width),
+					y = static_cast<int>(cell / grid_width) - 1;
 
-				auto &b = coord.get_component<belonging_chain>(e);
-				
-				entity up = g.board_blobs[x + y * grid_width];
-
-				while (y > -1 && up != 0u)
+				for (; y > -1; --y)
 				{
-					auto &bu = coord.get_component<belonging_chain>(up);
+					const std::size_t up_cell = x + y * grid_width;
+					entity up = g.board_blobs[up_cell];
 
-					if (bu.chain != 0u)
+					if (up == 0u || cleared.test(up_cell))
 						break;
 
 					auto &s = coord.get_component<state>(up);
 					s.blob_state = state_t::dropping;
-					f.pieces.push_back(up);
-
-					up = g.board_blobs[x + (--y) * grid_width];
+					f.push_back(up);
 				}
 			}
 		}
 
-		void clear_chains(coordinator &coord, entity &gr, entity &fall, entity &ch, entity &sc)
+		using clear_chains_access = access<reads<>, writes<grid, falling, chains, score, state>>;
+
+		// Cleared blobs leave the grid at once; their entities are destroyed when `cmds` is flushed.
+		inline void clear_chains(coordinator &coord, command_buffer &cmds, entity &gr, entity &fall, entity &ch, entity &sc)
 		{
+			auto &g = coord.get_component<grid>(gr);
+			auto &f = coord.get_component<falling>(fall);
 			auto &c = coord.get_component<chains>(ch);
 			auto &s = coord.get_component<score>(sc);
 
+			bitboard cleared{};
+
+			for (const auto &group : c)
+				cleared |= group.cells;
+
 			int multiplier = 10;
 
-			for (auto &pair : c.blob_chains)
+			for (const auto &group : c)
 			{
-				std::for_each(pair.second.begin(), pair.second.end(),
-					[&](entity &e)
+				group.cells.for_each(
+					[&](std::size_t cell)
 					{
-						set_falling(coord, gr, fall, ch, e);
-						delete_blob(coord, gr, e);
+						set_falling(coord, g, f, cleared, cell);
+
+						cmds.destroy(g.board_blobs[cell]);
+						remove_blob(g, cell, group.color);
 					}
 				);
 
-				s.current += multiplier * pair.second.size();
+				s.current += multiplier * group.size;
 				multiplier += 10;
-
-				coord.destroy_entity(pair.first);
 			}
 
-			c.blob_chains.clear();
+			c.clear();
 		}
 	}
 }
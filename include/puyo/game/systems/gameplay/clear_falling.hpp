@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../core/ecs/access.hpp"
 #include "../../core/ecs/coordinator.hpp"
 #include "../../core/ecs/entity.hpp"
 
@@ -9,10 +10,12 @@ namespace puyo
 {
 	namespace sys
 	{
-		void clear_falling(coordinator &coord, entity &fall)
+		using clear_falling_access = access<reads<>, writes<falling>>;
+
+		inline void clear_falling(coordinator &coord, entity &fall)
 		{
 			auto &f = coord.get_component<falling>(fall);
-			f.pieces.clear();
+			f.clear();
 		}
 	}
 }
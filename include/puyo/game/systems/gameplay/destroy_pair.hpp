@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../core/ecs/access.hpp"
 #include "../../core/ecs/coordinator.hpp"
 #include "../../core/ecs/entity.hpp"
 
@@ -7,7 +8,10 @@ namespace puyo
 {
 	namespace sys
 	{
-		void destroy_pair(coordinator &coord, entity &p)
+		// Exclusive: destroys the pair entity directly.
+		using destroy_pair_access = exclusive_access;
+
+		inline void destroy_pair(coordinator &coord, entity &p)
 		{
 			coord.destroy_entity(p);
 			p = 0u;
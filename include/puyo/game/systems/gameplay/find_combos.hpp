@@ -1,13 +1,17 @@
 #pragma once
 
-#include <algorithm>
+#include <cassert>
+#include <cstdint>
 
+#include "../../core/bitboard.hpp"
+#include "../../core/constants.hpp"
+#include "../../core/ecs/access.hpp"
 #include "../../core/ecs/coordinator.hpp"
 #include "../../core/ecs/entity.hpp"
+#include "../../core/label_groups.hpp"
+#include "../../core/zobrist.hpp"
 
-#include "../../components/gameplay/belonging_chain.hpp"
 #include "../../components/gameplay/chains.hpp"
-#include "../../components/gameplay/color.hpp"
 #include "../../components/gameplay/grid.hpp"
 #include "../../components/movement/transform.hpp"
 
@@ -15,100 +19,31 @@ namespace puyo
 {
 	namespace sys
 	{
-		namespace
-		{
-			void check_adjacent(coordinator &coord, entity &gr, entity &ch, entity &e, const sdl::ipoint &p)
-			{
-				auto &g = coord.get_component<grid>(gr);
-				auto &cs = coord.get_component<chains>(ch);
-
-				auto &c = coord.get_component<color>(e);
-				auto &t = coord.get_component<transform>(e);
-				std::size_t
-					x = t.grid_position.x(),
-					y = t.grid_position.y();
-
-				entity adj = g.board_blobs[(x + p.x()) + (y + p.y()) * grid_width];
-
-				if (adj == 0u)
-					return;
-
-				auto &ca = coord.get_component<color>(adj);
-
-				if (c.blob_color == ca.blob_color)
-				{
-					auto &b = coord.get_component<belonging_chain>(e);
-					auto &ba = coord.get_component<belonging_chain>(adj);
-
-					if (b.chain == 0u)
-					{
-						if (ba.chain == 0u)
-						{
-							entity new_chain = coord.create_entity();
-
-							cs.blob_chains[new_chain].push_back(e);
-							cs.blob_chains[new_chain].push_back(adj);
+		// Exclusive: advances the coordinator's change tick.
+		using find_combos_access = exclusive_access;
 
-							b.chain = new_chain;
-							ba.chain = new_chain;
-						}
-						else
-						{
-							cs.blob_chains[ba.chain].push_back(e);
-							b.chain = ba.chain;
-						}
-					}
-					else
-					{
-						if (ba.chain == 0u)
-						{
-							cs.blob_chains[b.chain].push_back(adj);
-							ba.chain = b.chain;
-						}
-						else if (ba.chain != b.chain)
-						{
-							cs.blob_chains[b.chain].insert(
-								cs.blob_chains[b.chain].begin(),
-								cs.blob_chains[ba.chain].begin(),
-								cs.blob_chains[ba.chain].end()
-							);
-
-							cs.blob_chains.erase(ba.chain);
-							coord.destroy_entity(ba.chain);
-
-							ba.chain = b.chain;
-						}
-					}
-				}
-			}
-		}
-
-		void find_combos(coordinator &coord, entity &gr, entity &ch)
+		inline void find_combos(coordinator &coord, entity &gr, entity &ch)
 		{
 			auto &g = coord.get_component<grid>(gr);
+			auto &cs = coord.get_component<chains>(ch);
 
-			std::for_each(g.board_blobs.begin(), g.board_blobs.end(),
-				[&](entity &e)
-				{
-					if (e == 0u)
-						return;
+			// Every board change since the last scan went through place_blob and remove_blob.
+			assert(g.hash == zobrist_hash(g.color_boards) && "Grid hash out of sync with its colour boards.");
 
-					auto &t = coord.get_component<transform>(e);
+			const std::uint32_t since = cs.scanned;
+			cs.scanned = coord.advance_change_tick();
 
-					int
-						x = t.grid_position.x(),
-						y = t.grid_position.y();
+			// Groups from before were cleared when found, so every new one holds a moved blob.
+			bitboard moved{};
 
-					if (x > 0)
-						check_adjacent(coord, gr, ch, e, { -1, 0 });
-					if (x < grid_width - 1)
-						check_adjacent(coord, gr, ch, e, { 1, 0 });
-					if (y > 0)
-						check_adjacent(coord, gr, ch, e, { 0, -1 });
-					if (y < grid_height - 1)
-						check_adjacent(coord, gr, ch, e, { 0, 1 });
+			coord.changed<transform>(since).each(
+				[&](entity, const transform &t)
+				{
+					moved.set(t.grid_position.x() + t.grid_position.y() * grid_width);
 				}
 			);
+
+			cs.count = label_groups(g.color_boards, moved, min_chain_size, cs.groups.data());
 		}
 	}
 }
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "../../core/bitboard.hpp"
+#include "../../core/constants.hpp"
+#include "../../core/ecs/access.hpp"
+#include "../../core/ecs/coordinator.hpp"
+#include "../../core/ecs/entity.hpp"
+#include "../../core/move_generator.hpp"
+
+#include "../../components/gameplay/color.hpp"
+#include "../../components/gameplay/grid.hpp"
+#include "../../components/gameplay/pair.hpp"
+#include "../../components/movement/transform.hpp"
+
+namespace puyo
+{
+	namespace sys
+	{
+		using generate_placements_access = access<reads<grid, pair, transform, color>, writes<>>;
+
+		// Every placement the current pair can still reach, for bots; the game is left as is.
+		inline std::size_t generate_placements(coordinator &coord, entity &gr, entity &e, placements &out)
+		{
+			const auto &g = coord.get_component<grid>(gr);
+			const auto &p = coord.get_component<pair>(e);
+
+			const auto &tc = coord.get_component<transform>(p.center);
+			const auto &to = coord.get_component<transform>(p.other);
+
+			const color_t cc = coord.get_component<color>(p.center).blob_color;
+			const color_t co = coord.get_component<color>(p.other).blob_color;
+
+			const int
+				xc = tc.grid_position.x(),
+				yc = tc.grid_position.y(),
+				xo = to.grid_position.x(),
+				yo = to.grid_position.y();
+
+			const std::size_t center_cell = xc + yc * grid_width;
+
+			// The pair is on the grid while it falls; take it off first.
+			std::array<bitboard, color_count> boards = g.color_boards;
+			boards[cc - 1].reset(center_cell);
+			boards[co - 1].reset(xo + yo * grid_width);
+
+			const orientation turn =
+				xo > xc ? orientation::right :
+				xo < xc ? orientation::left :
+				yo < yc ? orientation::up :
+				orientation::down;
+
+			return puyo::generate_placements(boards, center_cell, turn, cc, co, out.data());
+		}
+	}
+}
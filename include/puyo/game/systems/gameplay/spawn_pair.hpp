@@ -1,10 +1,14 @@
 #pragma once
 
-#include <random>
+#include <array>
+#include <cstddef>
 
 #include "../../core/constants.hpp"
+#include "../../core/ecs/access.hpp"
 #include "../../core/ecs/entity.hpp"
 #include "../../core/ecs/coordinator.hpp"
+#include "../../core/ecs/prefab.hpp"
+#include "../../core/piece_generator.hpp"
 
 #include "../../components/gameplay/color.hpp"
 #include "../../components/gameplay/grid.hpp"
@@ -18,47 +22,43 @@ namespace puyo
 {
 	namespace sys
 	{
-		namespace
+		// A blob at the top-left cell; spawn_pair sets the colour and position of each copy.
+		inline const prefab<color, state, transform, velocity, drawable> &blob_prefab()
 		{
-			void populate_blob(coordinator &coord, entity &blob, color_t col, sdl::ipoint pos)
-			{
-				coord.add_component<color>(blob, { col });
+			static const prefab<color, state, transform, velocity, drawable> blob{
+				color{ red },
+				state{ state_t::dropping },
+				transform{ { 0.f, 0.f }, { 0, 0 } },
+				velocity{ puyo::speed },
+				drawable{ 0, { { 0, 0 }, { 50, 50 } }, { { 0.f, 0.f }, { x_interval<>, x_interval<> } } }
+			};
 
-				coord.add_component<belonging_chain>(blob, { 0 });
-
-				coord.add_component<state>(blob, { state_t::dropping });
-
-				coord.add_component<transform>(blob, {
-						{ float(pos.x()) * x_interval<>, float(pos.y()) * y_interval<> },
-						{ pos.x(), pos.y() }
-				});
-
-				coord.add_component<velocity>(blob, { puyo::speed });
-
-				coord.add_component<drawable>(blob, {
-					0,
-					{ { (col - 1) * 50, 0 }, { 50, 50 } },
-					{ { float(pos.x()) * x_interval<>, float(pos.y()) * y_interval<> }, { x_interval<>, x_interval<> } }
-				});
-			}
+			return blob;
 		}
 
-		void spawn_pair(coordinator &coord, entity &e)
+		// Exclusive: creates entities directly.
+		using spawn_pair_access = exclusive_access;
+
+		inline void spawn_pair(coordinator &coord, entity &e, piece_generator &pieces)
 		{
-			e = coord.create_entity();
-			coord.add_component<pair>(e, {
-				coord.create_entity(),
-				coord.create_entity()
-			});
+			const piece next = pieces.next();
+			std::array<entity, 2> blobs;
 
-			auto &p = coord.get_component<pair>(e);
+			coord.instantiate(blob_prefab(), blobs.data(), blobs.size(),
+				[&](std::size_t i, color &c, state &, transform &t, velocity &, drawable &d)
+				{
+					const float y = float(i) * y_interval<>;
 
-			std::random_device r;
-			std::default_random_engine eng(r());
-			std::uniform_int_distribution<int> dist(1, 4);
+					c.blob_color = i == 0u ? next.center : next.other;
+					t.position.set_y(y);
+					t.grid_position.set_y(static_cast<int>(i));
+					d.src.set_x((c.blob_color - 1) * 50);
+					d.dst.set_y(y);
+				}
+			);
 
-			populate_blob(coord, p.center, static_cast<color_t>(dist(eng)), { 0, 0 });
-			populate_blob(coord, p.other, static_cast<color_t>(dist(eng)), { 0, 1 });
+			e = coord.create_entity();
+			coord.add_component<pair>(e, { blobs[0], blobs[1] });
 		}
 	}
 }
@@ -1,13 +1,17 @@
 #pragma once
 
-#include <algorithm>
+#include <cstdint>
 
+#include "../../core/constants.hpp"
+#include "../../core/ecs/access.hpp"
 #include "../../core/ecs/entity.hpp"
 #include "../../core/ecs/coordinator.hpp"
 
-#include "../../components/gameplay/grid.hpp"
+#include "../../components/gameplay/color.hpp"
+#include "../../components/gameplay/state.hpp"
 #include "../../components/graphics/drawable.hpp"
 #include "../../components/movement/transform.hpp"
+#include "../../components/movement/velocity.hpp"
 
 namespace puyo
 {
@@ -15,27 +19,37 @@ namespace puyo
 	{
 		namespace
 		{
-			void update_dst(coordinator &coord, entity &e)
+			void update_dst(const transform &t, drawable &d)
 			{
-				auto &t = coord.get_component<transform>(e);
-				auto &d = coord.get_component<drawable>(e);
-
 				d.dst.set_x(t.grid_position.x() * x_interval<>);
 				d.dst.set_y(t.grid_position.y() * y_interval<>);
 			}
 		}
 
-		void render_grid(coordinator &coord, graphics &gfx, entity &gr)
+		// Exclusive: advances the change tick and may register its group.
+		using render_grid_access = exclusive_access;
+
+		// Graphics only needs render(texture, src, dst), so benchmarks can drive this without SDL.
+		// `rendered` is the change tick of the previous call; only blobs moved since then get a
+		// new destination rectangle.
+		template <typename Graphics>
+		void render_grid(coordinator &coord, Graphics &gfx, std::uint32_t &rendered)
 		{
-			auto &g = coord.get_component<grid>(gr);
+			const std::uint32_t since = rendered;
+			rendered = coord.advance_change_tick();
+
+			coord.changed<transform>(since).each(
+				[&](entity e, const transform &t)
+				{
+					update_dst(t, coord.get_component<drawable>(e));
+				}
+			);
 
-			std::for_each(g.board_blobs.begin(), g.board_blobs.end(),
-				[&](entity &e)
+			// Every blob carries exactly these, so the group is the blob archetype: its arrays
+			// are walked front to back in lockstep.
+			coord.group<color, state, transform, velocity, drawable>().each(
+				[&](entity, const color &, const state &, const transform &, const velocity &, const drawable &d)
 				{
-					if (e == 0u)
-						return;
-					update_dst(coord, e);
-					auto &d = coord.get_component<drawable>(e);
 					gfx.render(d.texture, d.src, d.dst);
 				}
 			);
@@ -1,18 +1,19 @@
 #pragma once
 
-#include "../../core/input.hpp"
-
-#include "../../ctx/binds.hpp"
+#include "../../core/actions.hpp"
+#include "../../core/ecs/access.hpp"
 
 namespace puyo
 {
 	namespace sys
 	{
-		bool handle_general_input(bool &paused, const input &input)
+		using handle_general_input_access = access<reads<>, writes<>>;
+
+		inline bool handle_general_input(bool &paused, const actions &input)
 		{
-			if (input.keyboard.just_pressed(ctx::binds::restart))
+			if (input.restart)
 				return true;
-			else if (input.keyboard.just_pressed(ctx::binds::pause))
+			else if (input.pause)
 			{
 				paused = !paused;
 			}
@@ -2,20 +2,18 @@
 
 #include <tuple>
 
+#include "../../core/actions.hpp"
+#include "../../core/ecs/access.hpp"
 #include "../../core/ecs/entity.hpp"
 #include "../../core/ecs/coordinator.hpp"
-#include "../../core/input.hpp"
 #include "../../core/constants.hpp"
 
-#include "../../ctx/binds.hpp"
-
+#include "../../components/gameplay/color.hpp"
 #include "../../components/gameplay/grid.hpp"
 #include "../../components/gameplay/pair.hpp"
 #include "../../components/movement/transform.hpp"
 #include "../../components/movement/velocity.hpp"
 
-#include "../../ctx/binds.hpp"
-
 namespace puyo
 {
 	namespace sys
@@ -45,23 +43,12 @@ namespace puyo
 
 		namespace
 		{
-			enum class button_t
-			{
-				pressed,
-				released
-			};
-
-			std::tuple<bool, button_t> check_pressed_velocity(const sdl::keyboard &keyboard)
+			std::tuple<bool, drop_t> check_pressed_velocity(const actions &input)
 			{
-				if (keyboard.is_held(ctx::binds::down))
-					return std::make_tuple(true, button_t::pressed);
-				else if (keyboard.just_released(ctx::binds::down))
-					return std::make_tuple(true, button_t::released);
-
-				return std::make_tuple(false, button_t::released);
+				return std::make_tuple(input.drop != drop_t::none, input.drop);
 			}
 
-			void change_velocity(coordinator &coord, entity &e, button_t state)
+			void change_velocity(coordinator &coord, entity &e, drop_t state)
 			{
 				auto &p = coord.get_component<pair>(e);
 
@@ -70,14 +57,19 @@ namespace puyo
 
 				switch (state)
 				{
-					case (button_t::pressed):
+					case (drop_t::pressed):
 					{
 						vc.speed = vo.speed = speed * 2.f;
 						break;
 					}
-					case (button_t::released):
+					case (drop_t::released):
 					{
 						vc.speed = vo.speed = speed;
+						break;
+					}
+					case (drop_t::none):
+					{
+						break;
 					}
 				}
 			}
@@ -146,10 +138,10 @@ namespace puyo
 				return false;
 			}
 
-			std::tuple<bool, direction_t> check_pressed_move(const sdl::keyboard &keyboard)
+			std::tuple<bool, direction_t> check_pressed_move(const actions &input)
 			{
-				const auto left = keyboard.just_pressed(ctx::binds::left);
-				const auto right = keyboard.just_pressed(ctx::binds::right);
+				const auto left = input.left;
+				const auto right = input.right;
 
 				return std::make_tuple(left != right, left ? direction_t::left : direction_t::right);
 			}
@@ -205,10 +197,10 @@ namespace puyo
 				return false;
 			}
 
-			std::tuple<bool, direction_t> check_pressed_rotate(const sdl::keyboard &keyboard)
+			std::tuple<bool, direction_t> check_pressed_rotate(const actions &input)
 			{
-				const auto left = keyboard.just_pressed(ctx::binds::rotl);
-				const auto right = keyboard.just_pressed(ctx::binds::rotr);
+				const auto left = input.rotate_left;
+				const auto right = input.rotate_right;
 
 				return std::make_tuple(left != right, left ? direction_t::left : direction_t::right);
 			}
@@ -217,8 +209,8 @@ namespace puyo
 			{
 				auto &p = coord.get_component<pair>(e);
 
-				auto &tc = coord.get_component<transform>(p.center);
-				auto &to = coord.get_component<transform>(p.other);
+				auto &tc = coord.patch<transform>(p.center);
+				auto &to = coord.patch<transform>(p.other);
 
 				std::size_t
 					xc = tc.grid_position.x(),
@@ -229,9 +221,11 @@ namespace puyo
 				shape_t shape = get_shape(xc, yc, xo, yo);
 
 				auto &g = coord.get_component<grid>(gr);
+				auto &cc = coord.get_component<color>(p.center);
+				auto &co = coord.get_component<color>(p.other);
 
-				g.board_blobs[xc + yc * grid_width] = 0u;
-				g.board_blobs[xo + yo * grid_width] = 0u;
+				remove_blob(g, xc + yc * grid_width, cc.blob_color);
+				remove_blob(g, xo + yo * grid_width, co.blob_color);
 
 				switch (dir)
 				{
@@ -256,16 +250,16 @@ namespace puyo
 					}
 				}
 
-				g.board_blobs[xc + yc * grid_width] = p.center;
-				g.board_blobs[xo + yo * grid_width] = p.other;
+				place_blob(g, xc + yc * grid_width, p.center, cc.blob_color);
+				place_blob(g, xo + yo * grid_width, p.other, co.blob_color);
 			}
 
 			void rotate(coordinator &coord, entity &gr, entity &e, direction_t dir)
 			{
 				auto &p = coord.get_component<pair>(e);
 
-				auto &tc = coord.get_component<transform>(p.center);
-				auto &to = coord.get_component<transform>(p.other);
+				auto &tc = coord.patch<transform>(p.center);
+				auto &to = coord.patch<transform>(p.other);
 
 				std::size_t
 					xc = tc.grid_position.x(),
@@ -276,8 +270,9 @@ namespace puyo
 				shape_t shape = get_shape(xc, yc, xo, yo);
 
 				auto &g = coord.get_component<grid>(gr);
+				auto &co = coord.get_component<color>(p.other);
 
-				g.board_blobs[xo + yo * grid_width] = 0u;
+				remove_blob(g, xo + yo * grid_width, co.blob_color);
 
 				switch (dir)
 				{
@@ -350,27 +345,29 @@ namespace puyo
 					}
 				}
 
-				g.board_blobs[xo + yo * grid_width] = p.other;
+				place_blob(g, xo + yo * grid_width, p.other, co.blob_color);
 			}
 		}
 
-		void handle_pair_input(coordinator &coord, entity &gr, entity &e, const input &input)
+		using handle_pair_input_access = access<reads<pair, color>, writes<grid, transform, velocity>>;
+
+		inline void handle_pair_input(coordinator &coord, entity &gr, entity &e, const actions &input)
 		{
-			if (auto [check, dir] = check_pressed_move(input.keyboard); check)
+			if (auto [check, dir] = check_pressed_move(input); check)
 			{
 				if (can_move(coord, gr, e, dir))
 				{
 					move(coord, gr, e, dir);
 				}
 			}
-			else if (auto [check, dir] = check_pressed_rotate(input.keyboard); check)
+			else if (auto [check, dir] = check_pressed_rotate(input); check)
 			{
 				if (can_rotate(coord, gr, e, dir))
 				{
 					rotate(coord, gr, e, dir);
 				}
 			}
-			else if (auto [check, state] =  check_pressed_velocity(input.keyboard); check)
+			else if (auto [check, state] =  check_pressed_velocity(input); check)
 			{
 				change_velocity(coord, e, state);
 			}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../../core/constants.hpp"
+#include "../../core/ecs/access.hpp"
+#include "../../core/ecs/coordinator.hpp"
+#include "../../core/ecs/entity.hpp"
+
+#include "../../components/gameplay/color.hpp"
+#include "../../components/gameplay/grid.hpp"
+#include "../../components/gameplay/pair.hpp"
+#include "../../components/gameplay/state.hpp"
+#include "../../components/movement/transform.hpp"
+
+namespace puyo
+{
+	namespace sys
+	{
+		namespace
+		{
+			// Moves a blob that has left the grid straight down onto whatever is below it and puts
+			// it back, at rest, where fall_pieces would have left it.
+			void land_blob(coordinator &coord, grid &g, entity e)
+			{
+				auto &t = coord.patch<transform>(e);
+				auto &c = coord.get_component<color>(e);
+
+				const int x = t.grid_position.x();
+				int y = t.grid_position.y();
+
+				while (y < static_cast<int>(grid_height) - 1 && g.board_blobs[x + (y + 1) * grid_width] == 0u)
+					++y;
+
+				t.grid_position.set_y(y);
+				t.position.set_y(static_cast<float>(y * y_interval<>));
+				place_blob(g, x + y * grid_width, e, c.blob_color);
+
+				coord.get_component<state>(e).blob_state = state_t::placed;
+			}
+		}
+
+		using drop_pair_access = access<reads<pair, color>, writes<grid, state, transform>>;
+
+		// Hard drop: both blobs go straight to rest in one call, the lower one first, leaving the
+		// grid as try_move_pair and fall_pieces would after the pair lands.
+		inline void drop_pair(coordinator &coord, entity &gr, entity &e)
+		{
+			auto &g = coord.get_component<grid>(gr);
+			auto &p = coord.get_component<pair>(e);
+
+			const auto &tc = coord.get_component<transform>(p.center);
+			const auto &to = coord.get_component<transform>(p.other);
+
+			remove_blob(g, tc.grid_position.x() + tc.grid_position.y() * grid_width, coord.get_component<color>(p.center).blob_color);
+			remove_blob(g, to.grid_position.x() + to.grid_position.y() * grid_width, coord.get_component<color>(p.other).blob_color);
+
+			const bool other_first = to.grid_position.y() > tc.grid_position.y();
+
+			land_blob(coord, g, other_first ? p.other : p.center);
+			land_blob(coord, g, other_first ? p.center : p.other);
+		}
+	}
+}
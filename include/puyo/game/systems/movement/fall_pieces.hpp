@@ -3,11 +3,10 @@
 #include <algorithm>
 
 #include "../../core/constants.hpp"
+#include "../../core/ecs/access.hpp"
 #include "../../core/ecs/entity.hpp"
 #include "../../core/ecs/coordinator.hpp"
 
-#include "../../components/gameplay/belonging_chain.hpp"
-#include "../../components/gameplay/chains.hpp"
 #include "../../components/gameplay/color.hpp"
 #include "../../components/gameplay/falling.hpp"
 #include "../../components/gameplay/grid.hpp"
@@ -19,14 +18,16 @@ namespace puyo
 {
 	namespace sys
 	{
-		bool fall_pieces(coordinator &coord, entity &gr, entity &fall, entity &ch, float dt)
+		using fall_pieces_access = access<reads<falling, velocity, color>, writes<grid, state, transform>>;
+
+		inline bool fall_pieces(coordinator &coord, entity &gr, entity &fall, entity &ch, float dt)
 		{
 			auto &g = coord.get_component<grid>(gr);
 			auto &f = coord.get_component<falling>(fall);
 
 			bool res = false;
 
-			std::for_each(f.pieces.begin(), f.pieces.end(),
+			std::for_each(f.begin(), f.end(),
 				[&](entity &e)
 				{
 					auto &s = coord.get_component<state>(e);
@@ -34,7 +35,7 @@ namespace puyo
 					if (s.blob_state == state_t::placed)
 						return;
 
-					auto &t = coord.get_component<transform>(e);
+					auto &t = coord.patch<transform>(e);
 					auto &v = coord.get_component<velocity>(e);
 
 					t.position.set_y(t.position.y() + dt * v.speed);
@@ -48,18 +49,26 @@ namespace puyo
 					else if (y != t.grid_position.y())
 					{
 						if (y >= grid_height)
+						{
 							s.blob_state = state_t::placed;
+							t.position.set_y(t.grid_position.y() * y_interval<>);
+						}
 						else if (g.board_blobs[t.grid_position.x() + y * grid_width] != 0u)
 						{
 							auto &so = coord.get_component<state>(g.board_blobs[t.grid_position.x() + y * grid_width]);
 							if (so.blob_state == state_t::placed)
 								s.blob_state = state_t::placed;
+
+							// Hold on the current cell: left running, the position overshoots and
+							// the next fall skips rows, landing blobs out of order.
+							t.position.set_y(t.grid_position.y() * y_interval<>);
 						}
 						else
 						{
-							g.board_blobs[t.grid_position.x() + t.grid_position.y() * grid_width] = 0u;
+							auto &c = coord.get_component<color>(e);
+							remove_blob(g, t.grid_position.x() + t.grid_position.y() * grid_width, c.blob_color);
 							t.grid_position.set_y(y);
-							g.board_blobs[t.grid_position.x() + y * grid_width] = e;
+							place_blob(g, t.grid_position.x() + y * grid_width, e, c.blob_color);
 						}
 					}
 
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../../core/constants.hpp"
+#include "../../core/ecs/access.hpp"
+#include "../../core/ecs/coordinator.hpp"
+#include "../../core/ecs/entity.hpp"
+
+#include "../../components/gameplay/color.hpp"
+#include "../../components/gameplay/falling.hpp"
+#include "../../components/gameplay/grid.hpp"
+#include "../../components/gameplay/state.hpp"
+#include "../../components/movement/transform.hpp"
+
+namespace puyo
+{
+	namespace sys
+	{
+		using settle_pieces_access = access<reads<falling, color>, writes<grid, state, transform>>;
+
+		// Resolves a whole fall at once: every column holding a falling blob is compacted from
+		// the bottom up in one pass, and the falling blobs are left placed and snapped to their
+		// cells, as fall_pieces leaves them once it returns false.
+		inline void settle_pieces(coordinator &coord, entity &gr, entity &fall)
+		{
+			auto &g = coord.get_component<grid>(gr);
+			auto &f = coord.get_component<falling>(fall);
+
+			std::uint32_t columns = 0u;
+
+			for (entity e : f)
+				columns |= 1u << coord.get_component<transform>(e).grid_position.x();
+
+			for (std::size_t x = 0; x < grid_width; ++x)
+			{
+				if (((columns >> x) & 1u) == 0u)
+					continue;
+
+				int to = static_cast<int>(grid_height) - 1;
+
+				for (int y = to; y > -1; --y)
+				{
+					const entity e = g.board_blobs[x + y * grid_width];
+
+					if (e == 0u)
+						continue;
+
+					if (y != to)
+					{
+						const color_t c = coord.get_component<color>(e).blob_color;
+						remove_blob(g, x + y * grid_width, c);
+						place_blob(g, x + to * grid_width, e, c);
+
+						coord.get_component<transform>(e).grid_position.set_y(to);
+					}
+
+					--to;
+				}
+			}
+
+			for (entity e : f)
+			{
+				auto &t = coord.patch<transform>(e);
+				t.position.set_y(static_cast<float>(t.grid_position.y() * y_interval<>));
+
+				coord.get_component<state>(e).blob_state = state_t::placed;
+			}
+		}
+	}
+}
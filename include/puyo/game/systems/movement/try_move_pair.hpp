@@ -1,9 +1,11 @@
 #pragma once
 
 #include "../../core/constants.hpp"
+#include "../../core/ecs/access.hpp"
 #include "../../core/ecs/coordinator.hpp"
 #include "../../core/ecs/entity.hpp"
 
+#include "../../components/gameplay/color.hpp"
 #include "../../components/gameplay/grid.hpp"
 #include "../../components/gameplay/pair.hpp"
 #include "../../components/gameplay/state.hpp"
@@ -54,20 +56,22 @@ namespace puyo
 			}
 		}
 
-		bool try_move_pair(coordinator &coord, entity &e, entity &gr, float dt)
+		using try_move_pair_access = access<reads<pair, state, velocity, color>, writes<grid, transform>>;
+
+		inline bool try_move_pair(coordinator &coord, entity &e, entity &gr, float dt)
 		{
 			auto &p = coord.get_component<pair>(e);
 
 			auto &sc = coord.get_component<state>(p.center);
 			auto &so = coord.get_component<state>(p.other);
 
-			auto &tc = coord.get_component<transform>(p.center);
+			auto &tc = coord.patch<transform>(p.center);
 			auto &vc = coord.get_component<velocity>(p.center);
 
 			tc.position.set_y(tc.position.y() + dt * vc.speed);
 			int yc = static_cast<int>(tc.position.y() / y_interval<>);
 
-			auto &to = coord.get_component<transform>(p.other);
+			auto &to = coord.patch<transform>(p.other);
 			auto &vo = coord.get_component<velocity>(p.other);
 
 			to.position.set_y(to.position.y() + dt * vo.speed);
@@ -80,16 +84,18 @@ namespace puyo
 			else if (yc != tc.grid_position.y() && yo != to.grid_position.y() && can_move(coord, gr, tc.grid_position.x(), yc, to.grid_position.x(), yo))
 			{
 				auto &g = coord.get_component<grid>(gr);
-				g.board_blobs[tc.grid_position.x() + tc.grid_position.y() * grid_width] = 0u;
-				g.board_blobs[to.grid_position.x() + to.grid_position.y() * grid_width] = 0u;
+				auto &cc = coord.get_component<color>(p.center);
+				auto &co = coord.get_component<color>(p.other);
+				remove_blob(g, tc.grid_position.x() + tc.grid_position.y() * grid_width, cc.blob_color);
+				remove_blob(g, to.grid_position.x() + to.grid_position.y() * grid_width, co.blob_color);
 
 				// update grid positions
 				tc.grid_position.set_y(yc);
 				to.grid_position.set_y(yo);
 
 				// set blobs in grid
-				g.board_blobs[tc.grid_position.x() + yc * grid_width] = p.center;
-				g.board_blobs[to.grid_position.x() + yo * grid_width] = p.other;
+				place_blob(g, tc.grid_position.x() + yc * grid_width, p.center, cc.blob_color);
+				place_blob(g, to.grid_position.x() + yo * grid_width, p.other, co.blob_color);
 
 				return true;
 			}
@@ -0,0 +1,61 @@
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <puyo/common/log.hpp>
+#include <puyo/game/core/batch_engine.hpp>
+
+int main(int argc, char *argv[])
+{
+	puyo::log::init(true);
+
+	const std::uint64_t ticks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000u;
+	const std::size_t boards = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64u;
+
+	puyo::batch_engine batch{ boards };
+
+	for (std::size_t i = 0; i < boards; ++i)
+	{
+		batch[i].game().seed(i + 1u);
+		batch[i].game().set_resolve_mode(puyo::resolve_mode::instant);
+	}
+
+	std::vector<std::minstd_rand> engines;
+	engines.reserve(boards);
+
+	for (std::size_t i = 0; i < boards; ++i)
+		engines.emplace_back(static_cast<std::minstd_rand::result_type>(i + 1u));
+
+	batch.run(ticks,
+		[&](std::size_t board, puyo::game &)
+		{
+			puyo::actions act{};
+
+			switch (engines[board]() % 8u)
+			{
+			case 0: act.left = true; break;
+			case 1: act.right = true; break;
+			case 2: act.rotate_left = true; break;
+			case 3: act.rotate_right = true; break;
+			case 4: act.drop = puyo::drop_t::pressed; break;
+			default: break;
+			}
+
+			return act;
+		}
+	);
+
+	std::printf("%zu boards x %llu ticks on %zu threads in %.3f s (%.0f board-ticks/s)\n",
+		batch.size(), static_cast<unsigned long long>(ticks), batch.threads(), batch.elapsed().count(), batch.throughput());
+
+	if (batch.size() > 0u)
+	{
+		const puyo::memory_usage usage = batch[0].game().memory();
+
+		std::printf("board 0: %zu B entities, %zu B components, %zu B views, %.1f KiB total\n",
+			usage.entities, usage.components, usage.views, usage.total() / 1024.0);
+	}
+
+	return 0;
+}
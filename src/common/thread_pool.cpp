@@ -0,0 +1,90 @@
+#include "puyo/common/thread_pool.hpp"
+
+namespace puyo
+{
+	thread_pool::thread_pool(const std::size_t threads)
+	{
+		_workers.reserve(threads);
+
+		for (std::size_t i = 0; i < threads; ++i)
+			_workers.emplace_back([this] { _worker(); });
+	}
+
+	thread_pool::~thread_pool()
+	{
+		{
+			std::scoped_lock lock(_mutex);
+			_stop = true;
+		}
+
+		_wake.notify_all();
+
+		for (auto &worker : _workers)
+			worker.join();
+	}
+
+	std::size_t thread_pool::default_threads() noexcept
+	{
+		const unsigned int hw = std::thread::hardware_concurrency();
+		return hw > 1u ? hw - 1u : 0u;
+	}
+
+	void thread_pool::_dispatch(const std::size_t count, void *job, const invoke_type invoke)
+	{
+		if (count == 0u)
+			return;
+
+		{
+			std::scoped_lock lock(_mutex);
+			_job = job;
+			_invoke = invoke;
+			_count = count;
+			_next.store(0u, std::memory_order_relaxed);
+			_active = _workers.size();
+			++_generation;
+		}
+
+		_wake.notify_all();
+
+		_drain();
+
+		std::unique_lock lock(_mutex);
+		_done.wait(lock, [this] { return _active == 0u; });
+
+		_job = nullptr;
+		_invoke = nullptr;
+	}
+
+	void thread_pool::_drain()
+	{
+		for (std::size_t i = _next.fetch_add(1u, std::memory_order_relaxed); i < _count; i = _next.fetch_add(1u, std::memory_order_relaxed))
+			_invoke(_job, i);
+	}
+
+	void thread_pool::_worker()
+	{
+		std::uint64_t seen = 0;
+
+		while (true)
+		{
+			{
+				std::unique_lock lock(_mutex);
+				_wake.wait(lock, [&] { return _stop || _generation != seen; });
+
+				if (_stop)
+					return;
+
+				seen = _generation;
+			}
+
+			_drain();
+
+			{
+				std::scoped_lock lock(_mutex);
+				--_active;
+			}
+
+			_done.notify_one();
+		}
+	}
+}
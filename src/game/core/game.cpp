@@ -1,7 +1,9 @@
-#include "puyo/common/log.hpp"
 #include "puyo/game/core/game.hpp"
 
-#include "puyo/game/components/gameplay/belonging_chain.hpp"
+#include <cassert>
+
+#include "puyo/game/core/constants.hpp"
+
 #include "puyo/game/components/gameplay/color.hpp"
 #include "puyo/game/components/gameplay/falling.hpp"
 #include "puyo/game/components/gameplay/grid.hpp"
@@ -21,24 +23,34 @@
 #include "puyo/game/systems/gameplay/filter_chains.hpp"
 #include "puyo/game/systems/gameplay/find_combos.hpp"
 #include "puyo/game/systems/gameplay/spawn_pair.hpp"
-#include "puyo/game/systems/graphics/render_grid.hpp"
 #include "puyo/game/systems/general/reset_entities.hpp"
 #include "puyo/game/systems/input/handle_general_input.hpp"
 #include "puyo/game/systems/input/handle_pair_input.hpp"
+#include "puyo/game/systems/movement/drop_pair.hpp"
 #include "puyo/game/systems/movement/fall_pieces.hpp"
+#include "puyo/game/systems/movement/settle_pieces.hpp"
 #include "puyo/game/systems/movement/try_move_pair.hpp"
 
 namespace puyo
 {
-	void game::handle_input(const input &input)
+	void game::handle_input(const actions &input)
 	{
 		if (sys::handle_general_input(_paused, input))
 			_reset_game();
 
 		if (!_paused)
 		{
-			if (_state == _game_state::pair)
+			if (_state == _game_state::pair && _pair != 0u)
+			{
 				sys::handle_pair_input(_coord, _grid, _pair, input);
+
+				if (_resolve == resolve_mode::instant && input.drop == drop_t::pressed)
+				{
+					sys::drop_pair(_coord, _grid, _pair);
+					sys::destroy_pair(_coord, _pair);
+					_state = _game_state::score;
+				}
+			}
 		}
 	}
 
@@ -52,7 +64,7 @@ namespace puyo
 			{
 				if (_pair == 0u)
 				{
-					sys::spawn_pair(_coord, _pair);
+					sys::spawn_pair(_coord, _pair, _pieces);
 					if (sys::check_lose(_coord, _grid, _pair))
 						_reset_game();
 				}
@@ -71,7 +83,13 @@ namespace puyo
 
 			case _game_state::falling:
 			{
-				if (!sys::fall_pieces(_coord, _grid, _falling, _chains, dt))
+				if (_resolve == resolve_mode::instant)
+				{
+					sys::settle_pieces(_coord, _grid, _falling);
+					sys::clear_falling(_coord, _falling);
+					_state = _game_state::score;
+				}
+				else if (!sys::fall_pieces(_coord, _grid, _falling, _chains, dt))
 				{
 					sys::clear_falling(_coord, _falling);
 					_state = _game_state::score;
@@ -85,14 +103,8 @@ namespace puyo
 				sys::find_combos(_coord, _grid, _chains);
 				if (sys::filter_chains(_coord, _chains))
 				{
-					sys::clear_chains(_coord, _grid, _falling, _chains, _score);
+					sys::clear_chains(_coord, _commands, _grid, _falling, _chains, _score);
 					_state = _game_state::falling;
-
-					{
-						auto &s = _coord.get_component<score>(_score);
-						log::logline(log::info, "%d", s.current);
-					}
-
 				}
 				else
 					_state = _game_state::pair;
@@ -100,17 +112,13 @@ namespace puyo
 				break;
 			}
 			}
-		}
-	}
 
-	void game::render(graphics &gfx)
-	{
-		sys::render_grid(_coord, gfx, _grid);
+			_commands.flush(_coord);
+		}
 	}
 
 	void game::on_start()
 	{
-		_coord.register_component<belonging_chain>();
 		_coord.register_component<color>();
 		_coord.register_component<falling>();
 		_coord.register_component<grid>();
@@ -124,6 +132,9 @@ namespace puyo
 		_coord.register_component<transform>();
 		_coord.register_component<velocity>();
 
+		// find_combos and render_grid only look at blobs that moved.
+		_coord.track_changes<transform>();
+
 		_init_game();
 
 		_score = _coord.create_entity();
@@ -135,13 +146,73 @@ namespace puyo
 
 	}
 
+	void game::seed(std::uint64_t seed)
+	{
+		_pieces.reseed(seed);
+	}
+
+	void game::set_resolve_mode(resolve_mode mode)
+	{
+		_resolve = mode;
+	}
+
+	int game::current_score() const
+	{
+		return _coord.get_component<score>(_score).current;
+	}
+
+	std::uint64_t game::board_hash() const
+	{
+		return _coord.get_component<grid>(_grid).hash;
+	}
+
+	memory_usage game::memory() const
+	{
+		return _coord.memory();
+	}
+
+	void game::save(snapshot &snap) const
+	{
+		snap.clear();
+		_coord.save(snap);
+
+		snap.write(_pieces);
+		snap.write(_paused);
+		snap.write(_state);
+		snap.write(_grid);
+		snap.write(_falling);
+		snap.write(_chains);
+		snap.write(_pair);
+		snap.write(_score);
+	}
+
+	void game::restore(const snapshot &snap)
+	{
+		snapshot_reader reader{ snap };
+		_coord.restore(reader);
+
+		reader.read(&_pieces, 1u);
+		reader.read(&_paused, 1u);
+		reader.read(&_state, 1u);
+		reader.read(&_grid, 1u);
+		reader.read(&_falling, 1u);
+		reader.read(&_chains, 1u);
+		reader.read(&_pair, 1u);
+		reader.read(&_score, 1u);
+
+		assert(reader.done() && "Snapshot does not match this game.");
+
+		// The change tick may have gone back, so the next render refreshes every blob.
+		_rendered = 0u;
+	}
+
 	void game::_init_game()
 	{
 		_grid = _coord.create_entity();
 		_coord.add_component<grid>(_grid, { { 0 } });
 
 		_falling = _coord.create_entity();
-		_coord.add_component<falling>(_falling, { /* empty*/ });
+		_coord.add_component<falling>(_falling, { /* empty */ });
 
 		_chains = _coord.create_entity();
 		_coord.add_component<chains>(_chains, { /* empty */ });
@@ -0,0 +1,12 @@
+#include "puyo/game/core/game.hpp"
+#include "puyo/game/core/graphics.hpp"
+
+#include "puyo/game/systems/graphics/render_grid.hpp"
+
+namespace puyo
+{
+	void game::render(graphics &gfx)
+	{
+		sys::render_grid(_coord, gfx, _rendered);
+	}
+}